@@ -1,261 +1,634 @@
-#ifndef AUCTION_ALGO
-#define AUCTION_ALGO
-
-#include <vector>
-#include <limits>
-#include <algorithm>
-#include <queue>
-#include <cmath>
-
-namespace PARAMETRS
-{
-static double min_utility;
-static double max_utility;
-static double visibility_radius;
-const  double DISTANCE_OFFSET = 0.1;
-const  double epsilon = 1e-3;
-}
-
-// Структура для хранения координат
-struct Point
-{
-    double x, y;
-};
-
-// Функция для вычисления евклидова расстояния
-double calculate_distance(const Point& p1, const Point& p2)
-{
-    return std::sqrt(std::pow(p2.x - p1.x, 2) + std::pow(p2.y - p1.y, 2));
-}
-
-template<typename T>
-class AuctionAlgo
-{
-private:
-    // Вспомогательная функция для поиска максимума и индекса
-    std::pair<T, int> FindMax(const std::vector<T>& values)
-    {
-        T max_val = std::numeric_limits<T>::lowest();
-        int max_idx = -1;
-
-        for (size_t i = 0; i < values.size(); ++i)
-        {
-            if (values[i] > max_val)
-            {
-                max_val = values[i];
-                max_idx = i;
-            }
-        }
-        return {max_val, max_idx};
-    }
-
-    std::vector<std::vector<int>> FindConnectedComponents(const std::vector<std::vector<int>>& visibility)
-    {
-        int n = visibility.size();
-        std::vector<bool> visited(n, false);
-        std::vector<std::vector<int>> components;
-
-        for (int i = 0; i < n; ++i)
-        {
-            if (!visited[i])
-            {
-                std::vector<int> component;
-                std::queue<int> q;
-                q.push(i);
-                visited[i] = true;
-
-                while (!q.empty())
-                {
-                    int u = q.front();
-                    q.pop();
-                    component.push_back(u);
-
-                    for (int v = 0; v < n; ++v)
-                    {
-                        if (visibility[u][v] && !visited[v])
-                        {
-                            visited[v] = true;
-                            q.push(v);
-                        }
-                    }
-                }
-                components.push_back(component);
-            }
-        }
-        return components;
-    }
-
-    T RunningForComponent(int n, int m,
-            std::vector<std::vector<T>>& alpha,
-            double epsilon,
-            std::vector<int>& assignment)
-    {
-
-        // Инициализация цен задач
-        std::vector<T> prices(m, T(0));
-
-        // Инициализация назначений (робот -> задача)
-        assignment.resize(n, -1); // Изначально ни один робот не назначен
-
-        // Вспомогательный вектор для отслеживания, какая задача назначена какому роботу
-        std::vector<int> task_to_robot(m, -1); // -1 означает, что задача не назначена
-
-        // Начальное назначение: назначаем задачи уникально
-        for (int i = 0; i < n; ++i)
-        {
-            for (int task = 0; task < m; ++task)
-            {
-                if (task_to_robot[task] == -1)
-                {
-                    assignment[i] = task;
-                    task_to_robot[task] = i;
-                    break;
-                }
-            }
-        }
-
-        // Флаг для проверки, "счастливы" ли все роботы
-        bool all_happy = false;
-
-        while (!all_happy)
-        {
-            all_happy = true;
-
-            for (int i = 0; i < n; ++i)
-            {
-                // Вычисляем прибыль для текущей задачи (если робот назначен)
-                T current_profit = (assignment[i] != -1)
-                                       ? alpha[i][assignment[i]] - prices[assignment[i]]
-                                       : T(0);
-
-                // Находим максимальную прибыль по доступным задачам
-                T max_profit = T(0);
-                for (int j = 0; j < m; ++j)
-                {
-                    T profit = alpha[i][j] - prices[j];
-                    max_profit = std::max(max_profit, profit);
-                }
-
-                // Проверяем, "счастлив" ли робот
-                if (current_profit < max_profit - epsilon)
-                {
-                    all_happy = false; // Робот несчастлив, продолжаем
-
-                    // Находим задачу с максимальной прибылью, включая фиктивную
-                    std::vector<T> profits(m, std::numeric_limits<T>::lowest());
-                    for (int j = 0; j < m; ++j) {
-                        profits[j] = alpha[i][j] - prices[j];
-                    }
-                    profits.push_back(T(0)); // Прибыль для фиктивной задачи (неназначение)
-
-                    auto [v_i, t_i] = FindMax(profits); // v_i - максимальная прибыль, t_i - индекс задачи
-                    if (t_i == static_cast<int>(profits.size()) - 1) {
-                        t_i = -1; // Робот выбирает фиктивную задачу (неназначение)
-                    }
-
-                    // Находим вторую по величине прибыль
-                    profits[t_i == -1 ? profits.size() - 1 : t_i] = std::numeric_limits<T>::lowest();
-                    auto [w_i, _] = FindMax(profits); // w_i - вторая по величине прибыль
-
-                    // Если робот выбирает фиктивную задачу, не меняем цены
-                    if (t_i == -1)
-                    {
-                        if (assignment[i] != -1) {
-                            task_to_robot[assignment[i]] = -1; // Освобождаем старую задачу
-                        }
-                        assignment[i] = -1;
-                        continue;
-                    }
-
-                    // Находим робота, который сейчас назначен на задачу t_i
-                    int current_owner = task_to_robot[t_i];
-                    if (current_owner != -1)
-                    {
-                        // Старому владельцу даём неназначение (фиктивную задачу)
-                        assignment[current_owner] = -1;
-                    }
-
-                    if(assignment[i] != -1)
-                    {
-                        // Освобождаем старую задачу
-                        task_to_robot[assignment[i]] = -1;
-                    }
-
-                    // Новый робот получает новую задачу
-                    assignment[i] = t_i;
-                    task_to_robot[t_i] = i;
-
-                    // Обновляем цену задачи t_i
-                    prices[t_i] += (v_i - w_i + epsilon);
-                }
-            }
-        }
-
-        // Вычисление общей полезности (только для реальных задач)
-        T total_utility = 0;
-        for (int i = 0; i < n; ++i)
-        {
-            if (assignment[i] != -1) {
-                total_utility += alpha[i][assignment[i]];
-            }
-        }
-        return total_utility;
-    }
-
-
-public:
-    T Start(int n, int m,
-            std::vector<std::vector<T>>& alpha,
-            const std::vector<std::vector<int>>& visibility_robots,
-            double epsilon,
-            std::vector<int>& assignment)
-    {
-        // Находим компоненты связности
-        auto components = FindConnectedComponents(visibility_robots);
-
-        // Инициализация
-        assignment.resize(n, -1);
-        T total_utility = 0;
-
-        // Для хранения максимальной полезности по каждой задаче
-        std::vector<T> max_task_utility(m, std::numeric_limits<T>::lowest());
-
-        // 1. Выполняем аукцион для всех компонент
-        for (const auto& component : components)
-        {
-            std::vector<std::vector<T>> component_alpha;
-            for (int robot : component) {
-                component_alpha.push_back(alpha[robot]);
-            }
-
-            std::vector<int> component_assignment;
-            RunningForComponent(component.size(), m, component_alpha, epsilon, component_assignment);
-
-            // Обновляем назначения и максимальные полезности
-            for (size_t i = 0; i < component.size(); ++i)
-            {
-                int robot = component[i];
-                int task = component_assignment[i];
-                assignment[robot] = task;
-
-                // Обновляем максимальную полезность для задачи
-                if (task != -1) {
-                    max_task_utility[task] = std::max(max_task_utility[task],
-                                                      alpha[robot][task]);
-                }
-            }
-        }
-
-        // 2. Суммируем только максимальные полезности
-        for (int task = 0; task < m; ++task)
-        {
-            if (max_task_utility[task] > std::numeric_limits<T>::lowest()) {
-                total_utility += max_task_utility[task];
-            }
-        }
-
-        return total_utility;
-    }
-};
-
-#endif
+#ifndef AUCTION_ALGO
+#define AUCTION_ALGO
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <queue>
+#include <deque>
+#include <cmath>
+#include <chrono>
+#include <functional>
+
+#include "VisibilityGraph.hpp"
+#include "ComponentLabeler.hpp"
+#include "UtilityOracle.hpp"
+
+// Структура для хранения координат
+struct Point
+{
+    double x, y;
+};
+
+// Функция для вычисления евклидова расстояния
+inline double calculate_distance(const Point& p1, const Point& p2)
+{
+    double dx = p2.x - p1.x;
+    double dy = p2.y - p1.y;
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+// Наблюдатель за ходом аукциона (потоковая выдача промежуточных результатов).
+// Колбэки вызываются в потоке решателя; исключение из колбэка прерывает решение
+template<typename T>
+struct AuctionProgress
+{
+    // Не чаще чем раз в interval: назначения всех роботов на текущий момент (решённые
+    // компоненты - итог, компонента в работе - текущие торги, остальные - -1) и их
+    // полезность, посчитанная так же, как итог Start
+    std::chrono::steady_clock::duration interval = std::chrono::milliseconds(100);
+    std::function<void(const std::vector<int>& assignment, T utility,
+                       std::size_t components_done, std::size_t components)> on_progress;
+
+    // Компонента component решена: robots[k] получил задачу tasks[k] (или -1)
+    std::function<void(std::size_t component, const int* robots, const std::vector<int>& tasks)> on_component;
+};
+
+template<typename T>
+class AuctionAlgo
+{
+private:
+    // Промежуточная выдача внутри одного вызова Start
+    struct ProgressState
+    {
+        std::vector<int>* assignment = nullptr;  // назначения всех роботов
+        std::size_t components_done = 0;
+        std::size_t components = 0;
+        std::chrono::steady_clock::time_point next;
+        int bids_left = 1;                       // ставок до следующего чтения часов
+    };
+
+    // Часы читаются примерно раз в столько прочитанных полезностей (ставка - m штук)
+    static constexpr int report_clock_work = 1 << 16;
+
+    // Вспомогательная функция для поиска максимума и индекса
+    std::pair<T, int> FindMax(const std::vector<T>& values)
+    {
+        T max_val = std::numeric_limits<T>::lowest();
+        int max_idx = -1;
+
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (values[i] > max_val)
+            {
+                max_val = values[i];
+                max_idx = i;
+            }
+        }
+        return {max_val, max_idx};
+    }
+
+    static constexpr int max_reverse_rounds = 32;
+
+    // Обратный шаг аукциона (для задач, которые могут остаться свободными): свободная
+    // задача с положительной ценой сама снижает цену до второй по выгодности ставки
+    // минус epsilon / 2 и достаётся роботу, которому выгоднее всех. Прибыль этого
+    // робота растёт не меньше чем на epsilon / 2, epsilon-равновесие сохраняется, и
+    // прямые торги после шага не нужны. Освобождённая им задача обрабатывается в том же
+    // шаге. Задача, которая не нужна никому, получает нулевую цену.
+    // true - назначения изменились
+    template<typename Source>
+    static bool ReverseStep(int n, int m,
+            const Source& alpha,
+            const int* rows,
+            double epsilon,
+            std::vector<T>& prices,
+            std::vector<int>& assignment,
+            std::vector<int>& task_to_robot)
+    {
+        // Прибыль робота при текущих ценах; у неназначенного - 0
+        std::vector<T> profit(n);
+        for (int i = 0; i < n; ++i)
+        {
+            profit[i] = assignment[i] != -1 ? alpha.At(rows[i], assignment[i]) - prices[assignment[i]] : T(0);
+        }
+
+        std::vector<int> pending;
+        for (int task = m - 1; task >= 0; --task)
+        {
+            if (task_to_robot[task] == -1 && prices[task] > T(0))
+                pending.push_back(task);
+        }
+
+        bool changed = false;
+        while (!pending.empty())
+        {
+            int task = pending.back();
+            pending.pop_back();
+
+            T best = std::numeric_limits<T>::lowest();
+            T second = std::numeric_limits<T>::lowest();
+            int best_robot = -1;
+            for (int i = 0; i < n; ++i)
+            {
+                T value = alpha.At(rows[i], task) - profit[i];
+                if (value > best)
+                {
+                    second = best;
+                    best = value;
+                    best_robot = i;
+                }
+                else if (value > second)
+                {
+                    second = value;
+                }
+            }
+
+            if (best_robot == -1 || best <= epsilon)
+            {
+                prices[task] = T(0);
+                continue;
+            }
+
+            prices[task] = std::max(T(0), second - T(epsilon / 2));
+            int released = assignment[best_robot];
+            if (released != -1)
+            {
+                task_to_robot[released] = -1;
+                if (prices[released] > T(0))
+                    pending.push_back(released);
+            }
+            assignment[best_robot] = task;
+            task_to_robot[task] = best_robot;
+            profit[best_robot] = alpha.At(rows[best_robot], task) - prices[task];
+            changed = true;
+        }
+        return changed;
+    }
+
+    // Ставка робота i. false - робот "счастлив": ни одна задача (включая фиктивную)
+    // не выгоднее текущей больше чем на epsilon. Иначе робот забирает самую выгодную
+    // задачу или уходит в неназначение; evicted - вытесненный им робот или -1
+    template<typename Source>
+    bool Bid(int i, int m,
+            const Source& alpha,
+            const int* rows,
+            double epsilon,
+            std::vector<T>& prices,
+            std::vector<int>& assignment,
+            std::vector<int>& task_to_robot,
+            std::vector<T>& scratch,
+            std::vector<T>& profits,
+            int& evicted)
+    {
+        evicted = -1;
+        const T* row = alpha.Row(rows[i], scratch);
+
+        // Вычисляем прибыль для текущей задачи (если робот назначен)
+        T current_profit = (assignment[i] != -1)
+                               ? row[assignment[i]] - prices[assignment[i]]
+                               : T(0);
+
+        // Находим максимальную прибыль по доступным задачам
+        T max_profit = T(0);
+        for (int j = 0; j < m; ++j)
+        {
+            T profit = row[j] - prices[j];
+            max_profit = std::max(max_profit, profit);
+        }
+
+        // Проверяем, "счастлив" ли робот
+        if (current_profit >= max_profit - epsilon)
+            return false;
+
+        // Находим задачу с максимальной прибылью, включая фиктивную
+        profits.resize(m + 1);
+        for (int j = 0; j < m; ++j) {
+            profits[j] = row[j] - prices[j];
+        }
+        profits[m] = T(0); // Прибыль для фиктивной задачи (неназначение)
+
+        auto [v_i, t_i] = FindMax(profits); // v_i - максимальная прибыль, t_i - индекс задачи
+        if (t_i == static_cast<int>(profits.size()) - 1) {
+            t_i = -1; // Робот выбирает фиктивную задачу (неназначение)
+        }
+
+        // Находим вторую по величине прибыль
+        profits[t_i == -1 ? profits.size() - 1 : t_i] = std::numeric_limits<T>::lowest();
+        auto [w_i, _] = FindMax(profits); // w_i - вторая по величине прибыль
+
+        // Если робот выбирает фиктивную задачу, не меняем цены
+        if (t_i == -1)
+        {
+            if (assignment[i] != -1) {
+                task_to_robot[assignment[i]] = -1; // Освобождаем старую задачу
+            }
+            assignment[i] = -1;
+            return true;
+        }
+
+        // Находим робота, который сейчас назначен на задачу t_i
+        int current_owner = task_to_robot[t_i];
+        if (current_owner != -1)
+        {
+            // Старому владельцу даём неназначение (фиктивную задачу)
+            assignment[current_owner] = -1;
+            evicted = current_owner;
+        }
+
+        if(assignment[i] != -1)
+        {
+            // Освобождаем старую задачу
+            task_to_robot[assignment[i]] = -1;
+        }
+
+        // Новый робот получает новую задачу
+        assignment[i] = t_i;
+        task_to_robot[t_i] = i;
+
+        // Обновляем цену задачи t_i
+        prices[t_i] += (v_i - w_i + epsilon);
+        return true;
+    }
+
+    Components FindConnectedComponents(const VisibilityGraph& visibility)
+    {
+        int n = visibility.size();
+        std::vector<bool> visited(n, false);
+        Components components;
+        components.offsets.push_back(0);
+        components.indices.reserve(n);
+
+        for (int i = 0; i < n; ++i)
+        {
+            if (!visited[i])
+            {
+                // Очередью служит хвост indices, начиная с текущей компоненты
+                std::size_t head = components.indices.size();
+                components.indices.push_back(i);
+                visited[i] = true;
+
+                while (head < components.indices.size())
+                {
+                    int u = components.indices[head++];
+
+                    for (const int* v = visibility.begin(u); v != visibility.end(u); ++v)
+                    {
+                        if (!visited[*v])
+                        {
+                            visited[*v] = true;
+                            components.indices.push_back(*v);
+                        }
+                    }
+                }
+                components.offsets.push_back(components.indices.size());
+            }
+        }
+        return components;
+    }
+
+    // Сумма по задачам максимальной полезности назначенных на неё роботов - так же
+    // считается итог Start (задачу могут взять роботы разных компонент)
+    template<typename Source>
+    static T TaskUtility(int m, const Source& alpha, const std::vector<int>& assignment)
+    {
+        std::vector<T> max_task_utility(m, std::numeric_limits<T>::lowest());
+        for (std::size_t robot = 0; robot < assignment.size(); ++robot)
+        {
+            int task = assignment[robot];
+            if (task != -1)
+                max_task_utility[task] = std::max(max_task_utility[task], alpha.At(robot, task));
+        }
+
+        T total_utility = 0;
+        for (int task = 0; task < m; ++task)
+        {
+            if (max_task_utility[task] > std::numeric_limits<T>::lowest())
+                total_utility += max_task_utility[task];
+        }
+        return total_utility;
+    }
+
+    // Промежуточная выдача: не чаще чем раз в progress->interval текущие торги компоненты
+    // переносятся в общие назначения и отдаются наблюдателю. Вызывается после каждой
+    // ставки, поэтому часы читаются только раз в report_clock_work / m ставок
+    template<typename Source>
+    void Report(ProgressState& report, int n, int m, const Source& alpha, const int* rows,
+                const std::vector<int>& component_assignment)
+    {
+        if (--report.bids_left > 0)
+            return;
+        report.bids_left = std::max(1, report_clock_work / std::max(m, 1));
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now < report.next)
+            return;
+        report.next = now + progress->interval;
+
+        std::vector<int>& assignment = *report.assignment;
+        for (int i = 0; i < n; ++i)
+            assignment[rows[i]] = component_assignment[i];
+
+        progress->on_progress(assignment, TaskUtility(m, alpha, assignment), report.components_done, report.components);
+    }
+
+    // Аукцион для роботов rows[0..n-1]; строки полезностей берутся из источника alpha.
+    // report - промежуточная выдача (nullptr - без неё)
+    template<typename Source>
+    T RunningForComponent(int n, int m,
+            const Source& alpha,
+            const int* rows,
+            double epsilon,
+            std::vector<int>& assignment,
+            ProgressState* report = nullptr)
+    {
+        std::vector<T> prices;
+        return RunningForComponent(n, m, alpha, rows, epsilon, prices, assignment, false, report);
+    }
+
+    // warm = true - prices и assignment содержат начальное состояние (решение прошлого
+    // тика), иначе торги начинаются с нулевых цен. На выходе - итоговые цены и назначения
+    template<typename Source>
+    T RunningForComponent(int n, int m,
+            const Source& alpha,
+            const int* rows,
+            double epsilon,
+            std::vector<T>& prices,
+            std::vector<int>& assignment,
+            bool warm,
+            ProgressState* report = nullptr)
+    {
+        std::vector<T> scratch;
+        std::vector<T> profits;
+
+        // Вспомогательный вектор для отслеживания, какая задача назначена какому роботу
+        std::vector<int> task_to_robot(m, -1); // -1 означает, что задача не назначена
+
+        if (warm)
+        {
+            prices.resize(m, T(0));
+            assignment.resize(n, -1);
+
+            // Прошлое назначение может ссылаться на одну задачу дважды (компоненты слились) -
+            // задача остаётся у первого робота
+            for (int i = 0; i < n; ++i)
+            {
+                int task = assignment[i];
+                if (task < 0 || task >= m || task_to_robot[task] != -1)
+                    assignment[i] = -1;
+                else
+                    task_to_robot[task] = i;
+            }
+
+            // Свободные задачи начинают с нулевой цены, как при холодном старте, а цены
+            // занятых сдвигаются вниз на общую величину так, чтобы самая дешёвая стала
+            // нулевой. Выбор между задачами от сдвига не меняется, но без него цены
+            // растут от тика к тику, и всё больше роботов уходят в неназначение
+            T lowest_owned = std::numeric_limits<T>::max();
+            for (int task = 0; task < m; ++task)
+            {
+                if (task_to_robot[task] == -1)
+                    prices[task] = T(0);
+                else
+                    lowest_owned = std::min(lowest_owned, prices[task]);
+            }
+            if (lowest_owned != std::numeric_limits<T>::max() && lowest_owned > T(0))
+            {
+                for (int task = 0; task < m; ++task)
+                {
+                    if (task_to_robot[task] != -1)
+                        prices[task] -= lowest_owned;
+                }
+            }
+        }
+        else
+        {
+            // Инициализация цен задач
+            prices.assign(m, T(0));
+
+            // Инициализация назначений (робот -> задача)
+            assignment.resize(n, -1); // Изначально ни один робот не назначен
+
+            // Начальное назначение: назначаем задачи уникально
+            for (int i = 0; i < n; ++i)
+            {
+                for (int task = 0; task < m; ++task)
+                {
+                    if (task_to_robot[task] == -1)
+                    {
+                        assignment[i] = task;
+                        task_to_robot[task] = i;
+                        break;
+                    }
+                }
+            }
+        }
+
+        int evicted = -1;
+        if (!warm)
+        {
+            // Флаг для проверки, "счастливы" ли все роботы
+            bool all_happy = false;
+
+            while (!all_happy)
+            {
+                all_happy = true;
+
+                for (int i = 0; i < n; ++i)
+                {
+                    if (Bid(i, m, alpha, rows, epsilon, prices, assignment, task_to_robot, scratch, profits, evicted))
+                        all_happy = false; // Робот несчастлив, продолжаем
+
+                    if (report)
+                        Report(*report, n, m, alpha, rows, assignment);
+                }
+            }
+        }
+        else
+        {
+            // В прямых торгах цены только растут, и счастливый назначенный робот остаётся
+            // счастливым, пока его не вытеснят. Поэтому после первого прохода проверяются
+            // только вытесненные роботы - при тёплом старте их немного.
+            // Задача, которую робот бросил ради другой, остаётся свободной с ценой прошлого
+            // тика, и вытесненные роботы предпочитают неназначение. Прямые торги такую цену
+            // не снижают - это делает обратный шаг, после которого все роботы проверяются
+            // заново (страховка от округлений)
+            std::deque<int> unhappy;
+            for (int round = 0; ; ++round)
+            {
+                for (int i = 0; i < n; ++i)
+                    unhappy.push_back(i);
+
+                while (!unhappy.empty())
+                {
+                    int i = unhappy.front();
+                    unhappy.pop_front();
+                    if (Bid(i, m, alpha, rows, epsilon, prices, assignment, task_to_robot, scratch, profits, evicted) &&
+                        evicted != -1)
+                        unhappy.push_back(evicted);
+
+                    if (report)
+                        Report(*report, n, m, alpha, rows, assignment);
+                }
+
+                if (round == max_reverse_rounds ||
+                    !ReverseStep(n, m, alpha, rows, epsilon, prices, assignment, task_to_robot))
+                    break;
+            }
+        }
+
+        // Вычисление общей полезности (только для реальных задач)
+        T total_utility = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            if (assignment[i] != -1) {
+                total_utility += alpha.At(rows[i], assignment[i]);
+            }
+        }
+        return total_utility;
+    }
+
+
+private:
+    const AuctionProgress<T>* progress = nullptr;
+
+public:
+    // Наблюдатель за ходом Start по компонентам (nullptr - без него). Должен жить,
+    // пока идёт решение. Тёплый старт (ComponentState) промежуточных результатов не выдаёт
+    void SetProgress(const AuctionProgress<T>* observer) noexcept { progress = observer; }
+
+    // Состояние аукциона одной компоненты между решениями (сессии планирования)
+    struct ComponentState
+    {
+        std::vector<T> prices;        // цены задач; пусто - холодный старт
+        std::vector<int> assignment;  // задача каждого робота компоненты или -1
+        bool reuse = false;           // компонента не изменилась - торги не нужны
+    };
+
+    T Start(int n, int m,
+            std::vector<std::vector<T>>& alpha,
+            const VisibilityGraph& visibility_robots,
+            double epsilon,
+            std::vector<int>& assignment)
+    {
+        // Находим компоненты связности
+        return Start(n, m, alpha, FindConnectedComponents(visibility_robots), epsilon, assignment);
+    }
+
+    T Start(int n, int m,
+            std::vector<std::vector<T>>& alpha,
+            const Components& components,
+            double epsilon,
+            std::vector<int>& assignment)
+    {
+        return Start(n, m, DenseUtility<T>(alpha), components, epsilon, assignment);
+    }
+
+    // Source - источник полезностей с Row/At (DenseUtility, UtilityOracle)
+    template<typename Source>
+    T Start(int n, int m,
+            const Source& alpha,
+            const Components& components,
+            double epsilon,
+            std::vector<int>& assignment)
+    {
+        // Инициализация
+        assignment.resize(n, -1);
+        T total_utility = 0;
+
+        // Для хранения максимальной полезности по каждой задаче
+        std::vector<T> max_task_utility(m, std::numeric_limits<T>::lowest());
+
+        ProgressState report;
+        report.assignment = &assignment;
+        report.components = components.size();
+        report.next = std::chrono::steady_clock::now() + (progress ? progress->interval : std::chrono::steady_clock::duration{});
+        ProgressState* reporting = progress && progress->on_progress ? &report : nullptr;
+
+        // 1. Выполняем аукцион для всех компонент
+        for (std::size_t c = 0; c < components.size(); ++c)
+        {
+            const int* component = components.begin(c);
+            const std::size_t component_size = components.size(c);
+
+            // Строки компоненты читаются из источника напрямую, без копирования
+            std::vector<int> component_assignment;
+            RunningForComponent(component_size, m, alpha, component, epsilon, component_assignment, reporting);
+
+            // Обновляем назначения и максимальные полезности
+            for (size_t i = 0; i < component_size; ++i)
+            {
+                int robot = component[i];
+                int task = component_assignment[i];
+                assignment[robot] = task;
+
+                // Обновляем максимальную полезность для задачи
+                if (task != -1) {
+                    max_task_utility[task] = std::max(max_task_utility[task],
+                                                      alpha.At(robot, task));
+                }
+            }
+
+            report.components_done = c + 1;
+            if (progress && progress->on_component)
+                progress->on_component(c, component, component_assignment);
+        }
+
+        // 2. Суммируем только максимальные полезности
+        for (int task = 0; task < m; ++task)
+        {
+            if (max_task_utility[task] > std::numeric_limits<T>::lowest()) {
+                total_utility += max_task_utility[task];
+            }
+        }
+
+        return total_utility;
+    }
+
+    // Тёплый старт: states[c] - цены и назначения компоненты c, перенесённые с прошлого
+    // решения. Компоненты с reuse берутся как есть, остальные доторговываются от
+    // прошлых цен. На выходе states - новое состояние для следующего решения
+    template<typename Source>
+    T Start(int n, int m,
+            const Source& alpha,
+            const Components& components,
+            double epsilon,
+            std::vector<ComponentState>& states,
+            std::vector<int>& assignment)
+    {
+        assignment.assign(n, -1);
+        states.resize(components.size());
+
+        std::vector<T> max_task_utility(m, std::numeric_limits<T>::lowest());
+
+        for (std::size_t c = 0; c < components.size(); ++c)
+        {
+            const int* component = components.begin(c);
+            const std::size_t component_size = components.size(c);
+            ComponentState& state = states[c];
+
+            if (!state.reuse || state.assignment.size() != component_size)
+            {
+                const bool warm = !state.prices.empty();
+                if (!warm)
+                    state.assignment.clear();
+                RunningForComponent(component_size, m, alpha, component, epsilon, state.prices, state.assignment, warm);
+            }
+            state.reuse = false;
+
+            for (std::size_t i = 0; i < component_size; ++i)
+            {
+                int robot = component[i];
+                int task = state.assignment[i];
+                assignment[robot] = task;
+
+                if (task != -1) {
+                    max_task_utility[task] = std::max(max_task_utility[task],
+                                                      alpha.At(robot, task));
+                }
+            }
+        }
+
+        T total_utility = 0;
+        for (int task = 0; task < m; ++task)
+        {
+            if (max_task_utility[task] > std::numeric_limits<T>::lowest()) {
+                total_utility += max_task_utility[task];
+            }
+        }
+
+        return total_utility;
+    }
+};
+
+#endif
@@ -0,0 +1,261 @@
+#ifndef BATCH_RUNNER
+#define BATCH_RUNNER
+
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#include "SolverPool.hpp"
+
+enum class BatchOrder
+{
+    Completion,  // по мере готовности
+    Input        // в порядке добавления
+};
+
+// Пакет независимых задач на SolverPool. В пул одновременно отдаётся не больше
+// window задач пакета: этого хватает, чтобы занять все потоки, а очередь пула
+// остаётся доступной одиночным запросам. Если полоса всё равно заполнена, задача
+// ждёт освобождения места - пакет не получает 503.
+// Ошибка задачи становится её результатом и не затрагивает остальные.
+// Next/TryNext вызываются из одного потока; задачи добавляются до первого Next
+template<typename Result>
+class BatchRunner
+{
+public:
+    using Job = std::function<Result(double)>;
+
+    struct Item
+    {
+        std::size_t index = 0;
+        std::optional<Result> result;  // пусто, если задача завершилась ошибкой
+        std::string error;
+    };
+
+    BatchRunner(SolverPool& pool, BatchOrder order, std::size_t window)
+        : pool(pool), state(std::make_shared<State>())
+    {
+        state->order = order;
+        state->window = std::max<std::size_t>(1, window);
+    }
+
+    // Уже отданные в пул задачи доработают, ещё не начатые пропустят решение
+    ~BatchRunner()
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->cancelled = true;
+    }
+
+    BatchRunner(const BatchRunner&) = delete;
+    BatchRunner& operator=(const BatchRunner&) = delete;
+
+    // job(queue_wait_ms) выполняется в потоке полосы, выбранной по cells
+    void Add(std::size_t cells, Job job)
+    {
+        state->tasks.push_back({cells, std::move(job)});
+        state->results.emplace_back();
+        state->errors.emplace_back();
+        state->ready.push_back(false);
+    }
+
+    // Задача, которая не дошла до решения (например, не разобрана): сразу готова
+    void AddError(std::string error)
+    {
+        const std::size_t index = state->tasks.size();
+        Add(0, nullptr);
+        state->errors[index] = std::move(error);
+        Complete(*state, index);
+    }
+
+    [[nodiscard]] std::size_t Size() const noexcept { return state->tasks.size(); }
+
+    // Следующий результат; ждёт, пока он будет готов. false - пакет выдан целиком
+    bool Next(Item& item) { return Step(item, true); }
+
+    // Следующий результат, если он уже готов
+    bool TryNext(Item& item) { return Step(item, false); }
+
+private:
+    struct Task
+    {
+        std::size_t cells;
+        Job job;
+    };
+
+    struct State
+    {
+        std::mutex mutex;
+        std::condition_variable done;
+
+        BatchOrder order = BatchOrder::Completion;
+        std::size_t window = 1;
+
+        std::vector<Task> tasks;
+        std::vector<std::optional<Result>> results;
+        std::vector<std::string> errors;
+        std::vector<bool> ready;
+        std::deque<std::size_t> completed;  // только для BatchOrder::Completion
+
+        std::size_t next_submit = 0;
+        std::size_t next_emit = 0;          // только для BatchOrder::Input
+        std::size_t delivered = 0;
+        std::size_t in_flight = 0;
+        bool rejected = false;
+        bool cancelled = false;
+    };
+
+    // Вызывается под state.mutex (или до того, как задачи попали в пул)
+    static void Complete(State& s, std::size_t index)
+    {
+        s.ready[index] = true;
+        if (s.order == BatchOrder::Completion)
+            s.completed.push_back(index);
+    }
+
+    // Выполнение задачи в потоке пула. State держится shared_ptr, поэтому задача
+    // может пережить BatchRunner (клиент отключился, пакет брошен)
+    static void Run(const std::shared_ptr<State>& s, std::size_t index, double queue_wait_ms)
+    {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(s->mutex);
+            if (!s->cancelled)
+                job = std::move(s->tasks[index].job);
+        }
+
+        std::optional<Result> result;
+        std::string error = "batch cancelled";
+        if (job)
+        {
+            try
+            {
+                result.emplace(job(queue_wait_ms));
+                error.clear();
+            }
+            catch (const std::exception& e)
+            {
+                error = e.what();
+            }
+            catch (...)
+            {
+                error = "unknown error";
+            }
+            // Данные задачи освобождаются сразу, а не вместе с пакетом
+            job = nullptr;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(s->mutex);
+            s->results[index] = std::move(result);
+            s->errors[index] = std::move(error);
+            s->in_flight--;
+            Complete(*s, index);
+        }
+        s->done.notify_all();
+    }
+
+    // Отдаёт в пул задачи, пока есть место в окне и в полосе
+    void Submit()
+    {
+        State& s = *state;
+        while (true)
+        {
+            std::size_t index;
+            {
+                std::lock_guard<std::mutex> lock(s.mutex);
+                s.rejected = false;
+                while (s.next_submit < s.tasks.size() && !s.tasks[s.next_submit].job)
+                    s.next_submit++;
+                if (s.next_submit == s.tasks.size() || s.in_flight >= s.window)
+                    return;
+
+                index = s.next_submit++;
+                s.in_flight++;
+            }
+
+            auto submitted = pool.TrySubmit(s.tasks[index].cells, [state = state, index](double queue_wait_ms) {
+                Run(state, index, queue_wait_ms);
+            });
+
+            if (!submitted)
+            {
+                std::lock_guard<std::mutex> lock(s.mutex);
+                s.next_submit = index;
+                s.in_flight--;
+                s.rejected = true;
+                return;
+            }
+        }
+    }
+
+    bool Take(Item& item)
+    {
+        State& s = *state;
+
+        std::size_t index;
+        if (s.order == BatchOrder::Completion)
+        {
+            if (s.completed.empty())
+                return false;
+            index = s.completed.front();
+            s.completed.pop_front();
+        }
+        else
+        {
+            if (s.next_emit == s.tasks.size() || !s.ready[s.next_emit])
+                return false;
+            index = s.next_emit++;
+        }
+
+        item.index = index;
+        item.result = std::move(s.results[index]);
+        item.error = std::move(s.errors[index]);
+        s.results[index].reset();
+        s.delivered++;
+        return true;
+    }
+
+    bool Step(Item& item, bool wait)
+    {
+        State& s = *state;
+        while (true)
+        {
+            // Освободившиеся места окна заполняются до выдачи результата,
+            // чтобы пул не простаивал, пока вызывающий пишет ответ
+            Submit();
+
+            std::unique_lock<std::mutex> lock(s.mutex);
+            if (s.delivered == s.tasks.size())
+                return false;
+            if (Take(item))
+                return true;
+            if (!wait)
+                return false;
+
+            auto deliverable = [&] {
+                return s.order == BatchOrder::Completion ? !s.completed.empty() : s.ready[s.next_emit];
+            };
+
+            // Полоса была заполнена чужими задачами - повторяем попытку, даже если
+            // своих задач в работе нет
+            if (s.rejected)
+                s.done.wait_for(lock, std::chrono::milliseconds(1), deliverable);
+            else
+                s.done.wait(lock, deliverable);
+        }
+    }
+
+private:
+    SolverPool& pool;
+    std::shared_ptr<State> state;
+};
+
+#endif
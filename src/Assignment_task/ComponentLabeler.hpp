@@ -0,0 +1,187 @@
+#ifndef COMPONENT_LABELER
+#define COMPONENT_LABELER
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+
+#include "Coords.hpp"
+#include "Parallel.hpp"
+#include "VisibilityGraph.hpp"
+
+// Компоненты связности в плоском виде: роботы компоненты c -
+// indices[offsets[c]] .. indices[offsets[c + 1] - 1]. Компоненты упорядочены
+// по наименьшему роботу; LabelComponents перечисляет роботов компоненты
+// по возрастанию номера, FindConnectedComponents - в порядке обхода в ширину
+struct Components
+{
+    std::vector<std::size_t> offsets;
+    std::vector<int> indices;
+
+    [[nodiscard]] std::size_t size() const noexcept { return offsets.empty() ? 0 : offsets.size() - 1; }
+    [[nodiscard]] std::size_t size(std::size_t c) const noexcept { return offsets[c + 1] - offsets[c]; }
+    [[nodiscard]] const int* begin(std::size_t c) const noexcept { return indices.data() + offsets[c]; }
+    [[nodiscard]] const int* end(std::size_t c) const noexcept { return indices.data() + offsets[c + 1]; }
+};
+
+
+// Система непересекающихся множеств без блокировок. Родитель и ранг упакованы
+// в одно 64-битное слово (ранг в старших 32 битах), поэтому объединение по рангу -
+// один CAS. Find сжимает путь делением пополам, тоже через CAS: проигравший поток
+// просто идёт дальше, корень от этого не меняется
+class ConcurrentUnionFind
+{
+public:
+    explicit ConcurrentUnionFind(std::size_t n) : data(n)
+    {
+        if (n > UINT32_MAX)
+        {
+            throw std::invalid_argument("ConcurrentUnionFind supports at most 2^32 elements");
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+            data[i].store(i, std::memory_order_relaxed);
+    }
+
+    std::uint32_t Find(std::uint32_t id)
+    {
+        while (true)
+        {
+            std::uint64_t value = data[id].load();
+            std::uint32_t parent = Parent(value);
+            if (parent == id)
+                return id;
+
+            std::uint64_t parent_value = data[parent].load();
+            std::uint32_t grandparent = Parent(parent_value);
+            if (grandparent != parent)
+            {
+                std::uint64_t halved = (value & rank_mask) | grandparent;
+                data[id].compare_exchange_weak(value, halved);
+            }
+            id = grandparent;
+        }
+    }
+
+    void Unite(std::uint32_t a, std::uint32_t b)
+    {
+        while (true)
+        {
+            a = Find(a);
+            b = Find(b);
+            if (a == b)
+                return;
+
+            std::uint64_t value_a = data[a].load();
+            std::uint64_t value_b = data[b].load();
+            std::uint32_t rank_a = Rank(value_a);
+            std::uint32_t rank_b = Rank(value_b);
+
+            // Подвешиваем корень с меньшим рангом (при равенстве - с меньшим номером)
+            if (rank_a > rank_b || (rank_a == rank_b && a > b))
+            {
+                std::swap(a, b);
+                std::swap(value_a, value_b);
+                std::swap(rank_a, rank_b);
+            }
+
+            // a мог перестать быть корнем - тогда CAS не пройдёт и всё начнётся заново
+            if (Parent(value_a) != a || !data[a].compare_exchange_strong(value_a, (value_a & rank_mask) | b))
+                continue;
+
+            if (rank_a == rank_b)
+            {
+                std::uint64_t expected = (static_cast<std::uint64_t>(rank_b) << 32) | b;
+                data[b].compare_exchange_strong(expected, (static_cast<std::uint64_t>(rank_b + 1) << 32) | b);
+            }
+            return;
+        }
+    }
+
+private:
+    static constexpr std::uint64_t rank_mask = 0xFFFFFFFF00000000ull;
+
+    static std::uint32_t Parent(std::uint64_t value) noexcept { return static_cast<std::uint32_t>(value); }
+    static std::uint32_t Rank(std::uint64_t value) noexcept { return static_cast<std::uint32_t>(value >> 32); }
+
+private:
+    std::vector<std::atomic<std::uint64_t>> data;
+};
+
+
+// Раскладывает роботов по корням в плоский Components
+inline void CollectComponents(ConcurrentUnionFind& sets, std::size_t n, Components& components,
+                              std::size_t threads = 0)
+{
+    std::vector<std::uint32_t> root(n);
+    ParallelFor(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; ++i)
+            root[i] = sets.Find(static_cast<std::uint32_t>(i));
+    }, 4096, threads);
+
+    // Номер компоненты - порядок появления корня при проходе по возрастанию роботов
+    std::vector<std::uint32_t> label(n, UINT32_MAX);
+    std::vector<std::size_t> counts;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        std::uint32_t& id = label[root[i]];
+        if (id == UINT32_MAX)
+        {
+            id = static_cast<std::uint32_t>(counts.size());
+            counts.push_back(0);
+        }
+        counts[id]++;
+    }
+
+    components.offsets.assign(counts.size() + 1, 0);
+    for (std::size_t c = 0; c < counts.size(); ++c)
+        components.offsets[c + 1] = components.offsets[c] + counts[c];
+
+    components.indices.resize(n);
+    std::vector<std::size_t> fill(components.offsets.begin(), components.offsets.end() - 1);
+    for (std::size_t i = 0; i < n; ++i)
+        components.indices[fill[label[root[i]]]++] = static_cast<int>(i);
+}
+
+
+// Компоненты связности графа видимости без построения списков смежности:
+// пары соседних ячеек сетки делятся между потоками, и каждая пара роботов
+// в пределах радиуса сразу объединяется
+inline void LabelComponents(const Coords& robots, double radius, Components& components, std::size_t threads = 0)
+{
+    const std::size_t n = robots.size();
+    const double radius_sq = radius * radius;
+
+    ConcurrentUnionFind sets(n);
+
+    if (radius >= 0.0 && n > 1)
+    {
+        // Ячейка чуть больше радиуса, чтобы пары ровно на границе не терялись из-за округления
+        SpatialGrid grid;
+        grid.Build(robots, radius * (1.0 + 1e-9));
+
+        auto visit = [&](std::size_t a, std::size_t b) {
+            for (const int* p = grid.Begin(a); p != grid.End(a); ++p)
+            {
+                const int* q = (a == b) ? p + 1 : grid.Begin(b);
+                for (; q != grid.End(b); ++q)
+                {
+                    double dx = robots.x[*q] - robots.x[*p];
+                    double dy = robots.y[*q] - robots.y[*p];
+                    if (dx * dx + dy * dy <= radius_sq)
+                        sets.Unite(*p, *q);
+                }
+            }
+        };
+
+        ParallelFor(0, grid.NumCells(), [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t c = begin; c < end; ++c)
+                grid.ForEachNeighbourCell(c, visit);
+        }, 256, threads);
+    }
+
+    CollectComponents(sets, n, components, threads);
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef COORDS
+#define COORDS
+
+#include <vector>
+#include <cstddef>
+
+// Координаты роботов или задач в виде структуры массивов: x и y лежат
+// в отдельных непрерывных массивах, что позволяет векторизовать расчёт расстояний
+struct Coords
+{
+    std::vector<double> x;
+    std::vector<double> y;
+
+    Coords() = default;
+    explicit Coords(std::size_t count) : x(count), y(count) {}
+
+    [[nodiscard]] std::size_t size() const noexcept { return x.size(); }
+
+    void resize(std::size_t count)
+    {
+        x.resize(count);
+        y.resize(count);
+    }
+
+    void reserve(std::size_t count)
+    {
+        x.reserve(count);
+        y.reserve(count);
+    }
+
+    void Set(std::size_t i, double px, double py) noexcept
+    {
+        x[i] = px;
+        y[i] = py;
+    }
+};
+
+#endif
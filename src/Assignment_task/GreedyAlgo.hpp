@@ -0,0 +1,156 @@
+#ifndef GREEDY_ALGO
+#define GREEDY_ALGO
+
+#include <vector>
+#include <queue>
+#include <limits>
+#include <algorithm>
+
+// Глобальный жадный алгоритм: пары (робот, задача) принимаются по убыванию полезности,
+// если робот и задача ещё свободны. Полный список n*m пар не строится: у каждого
+// робота хранится k лучших задач, а в очереди - его текущая лучшая свободная задача.
+// Если задачу заняли, робот берёт следующую из своего списка, а когда список исчерпан -
+// пересчитывает его по строке. Устаревшие записи очереди не мешают: значение у робота
+// может только уменьшаться, поэтому вынутая из очереди актуальная пара - глобально лучшая.
+// Память O(n * k + m), так что источник полезностей может быть ленивым (UtilityOracle).
+template<typename T>
+class GreedyAlgo
+{
+public:
+    explicit GreedyAlgo(std::size_t candidates = 8) noexcept : k(std::max<std::size_t>(candidates, 1)) {}
+
+    // Source - источник полезностей с Row/At (DenseUtility, UtilityOracle)
+    template<typename Source>
+    T Start(int n, int m, const Source& alpha, std::vector<int>& assignment)
+    {
+        assignment.assign(n, -1);
+        if (n <= 0 || m <= 0)
+            return T(0);
+
+        k_eff = std::min<std::size_t>(k, m);
+        task_taken.assign(m, false);
+        candidates.assign(static_cast<std::size_t>(n) * k_eff, -1);
+        cursor.assign(n, 0);
+        count.assign(n, 0);
+
+        // Очередь: (полезность, -робот) - при равенстве раньше идёт робот с меньшим номером
+        std::priority_queue<std::pair<T, int>> queue;
+
+        for (int i = 0; i < n; ++i)
+        {
+            Refill(alpha, i);
+            if (count[i] > 0)
+                queue.push({Value(alpha, i), -i});
+        }
+
+        T total_utility = T(0);
+        int tasks_left = m;
+
+        while (!queue.empty() && tasks_left > 0)
+        {
+            auto [value, neg_robot] = queue.top();
+            queue.pop();
+            int i = -neg_robot;
+
+            if (!Advance(alpha, i))
+                continue;
+
+            T current = Value(alpha, i);
+            if (current < value)
+            {
+                // Лучшая задача робота уже занята - возвращаем его с новым значением
+                queue.push({current, -i});
+                continue;
+            }
+
+            int task = candidates[Slot(i)];
+            assignment[i] = task;
+            task_taken[task] = true;
+            total_utility += current;
+            tasks_left--;
+        }
+
+        return total_utility;
+    }
+
+private:
+    std::size_t Slot(int i) const noexcept { return static_cast<std::size_t>(i) * k_eff + cursor[i]; }
+
+    template<typename Source>
+    T Value(const Source& alpha, int i) const { return alpha.At(i, candidates[Slot(i)]); }
+
+    // Сдвигает курсор робота на первую свободную задачу, при необходимости пересчитывая список
+    template<typename Source>
+    bool Advance(const Source& alpha, int i)
+    {
+        while (true)
+        {
+            while (cursor[i] < count[i] && task_taken[candidates[Slot(i)]])
+                cursor[i]++;
+
+            if (cursor[i] < count[i])
+                return true;
+
+            Refill(alpha, i);
+            if (count[i] == 0)
+                return false;
+        }
+    }
+
+    // k лучших свободных задач строки i с положительной полезностью, по убыванию
+    template<typename Source>
+    void Refill(const Source& alpha, int i)
+    {
+        const T* row = alpha.Row(i, scratch);
+        const int m = static_cast<int>(task_taken.size());
+
+        best.clear();
+        for (int j = 0; j < m; ++j)
+        {
+            if (task_taken[j] || !(row[j] > T(0)))
+                continue;
+
+            if (best.size() < k_eff)
+            {
+                best.push_back({row[j], j});
+                std::push_heap(best.begin(), best.end(), Better);
+            }
+            else if (Better({row[j], j}, best.front()))
+            {
+                std::pop_heap(best.begin(), best.end(), Better);
+                best.back() = {row[j], j};
+                std::push_heap(best.begin(), best.end(), Better);
+            }
+        }
+
+        std::sort(best.begin(), best.end(), Better);
+
+        int* list = candidates.data() + static_cast<std::size_t>(i) * k_eff;
+        for (std::size_t c = 0; c < best.size(); ++c)
+            list[c] = best[c].second;
+
+        cursor[i] = 0;
+        count[i] = best.size();
+    }
+
+    // Порядок "лучше": больше полезность, при равенстве - меньший номер задачи.
+    // В куче на вершине оказывается худшая из k задач, sort упорядочивает от лучшей
+    static bool Better(const std::pair<T, int>& a, const std::pair<T, int>& b) noexcept
+    {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    }
+
+private:
+    std::size_t k = 8;
+    std::size_t k_eff = 8;
+
+    std::vector<bool> task_taken;
+    std::vector<int> candidates;
+    std::vector<std::size_t> cursor;
+    std::vector<std::size_t> count;
+
+    std::vector<std::pair<T, int>> best;
+    std::vector<T> scratch;
+};
+
+#endif
@@ -0,0 +1,253 @@
+#ifndef LOGGER
+#define LOGGER
+
+#include <ctime>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <string_view>
+
+// Асинхронный журнал с уровнями. Потоки запросов только форматируют строку
+// в ячейку кольцевого буфера (без блокировок и выделений памяти), а запись
+// в файл и flush делает фоновый поток. Если буфер заполнен, запись
+// отбрасывается и учитывается в Dropped() - журнал никогда не тормозит запрос.
+//
+// Кольцо - ограниченная очередь Вьюкова: у каждой ячейки свой номер
+// последовательности, производители занимают позицию через CAS на head,
+// единственный потребитель читает по tail.
+enum class LogLevel : int
+{
+    Debug = 0,
+    Info = 1,
+    Warning = 2,
+    Error = 3
+};
+
+inline const char* LogLevelName(LogLevel level) noexcept
+{
+    switch (level)
+    {
+    case LogLevel::Debug: return "DEBUG";
+    case LogLevel::Info: return "INFO";
+    case LogLevel::Warning: return "WARN";
+    case LogLevel::Error: return "ERROR";
+    }
+    return "?";
+}
+
+// "debug", "info", "warning", "error"; иначе false
+inline bool ParseLogLevel(std::string_view name, LogLevel& level) noexcept
+{
+    if (name == "debug") level = LogLevel::Debug;
+    else if (name == "info") level = LogLevel::Info;
+    else if (name == "warning") level = LogLevel::Warning;
+    else if (name == "error") level = LogLevel::Error;
+    else return false;
+    return true;
+}
+
+class Logger
+{
+public:
+    static constexpr std::size_t text_size = 512;
+
+    // capacity округляется вверх до степени двойки
+    explicit Logger(std::size_t capacity = 4096, std::FILE* output = stdout)
+        : output(output)
+    {
+        std::size_t size = 1;
+        while (size < capacity)
+            size <<= 1;
+
+        slots.reset(new Slot[size]);
+        mask = size - 1;
+        for (std::size_t i = 0; i < size; ++i)
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+
+        writer = std::thread([this] { Run(); });
+    }
+
+    // Всё, что успели записать до разрушения, выводится
+    ~Logger()
+    {
+        stopping.store(true, std::memory_order_release);
+        writer.join();
+    }
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    void SetLevel(LogLevel level) noexcept { min_level.store(static_cast<int>(level), std::memory_order_relaxed); }
+    [[nodiscard]] LogLevel Level() const noexcept { return static_cast<LogLevel>(min_level.load(std::memory_order_relaxed)); }
+
+    // Проверка до форматирования: отладочные дампы не стоят ничего, если уровень выше
+    [[nodiscard]] bool Enabled(LogLevel level) const noexcept
+    {
+        return static_cast<int>(level) >= min_level.load(std::memory_order_relaxed);
+    }
+
+    void Write(LogLevel level, std::string_view text) noexcept
+    {
+        Printf(level, "%.*s", static_cast<int>(text.size()), text.data());
+    }
+
+    // Строка форматируется прямо в ячейку; длиннее text_size - обрезается
+    template<typename... Args>
+    void Printf(LogLevel level, const char* format, Args... args) noexcept
+    {
+        if (!Enabled(level))
+            return;
+
+        std::size_t position;
+        Slot* slot = Claim(position);
+        if (!slot)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        slot->level = level;
+        slot->time = std::chrono::system_clock::now();
+
+        int length;
+        if constexpr (sizeof...(Args) == 0)
+            length = std::snprintf(slot->text, text_size, "%s", format);
+        else
+            length = std::snprintf(slot->text, text_size, format, args...);
+        slot->length = length < 0 ? 0 : std::min<std::size_t>(length, text_size - 1);
+
+        slot->sequence.store(position + 1, std::memory_order_release);
+    }
+
+    [[nodiscard]] std::size_t Dropped() const noexcept { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence{0};
+        LogLevel level = LogLevel::Info;
+        std::chrono::system_clock::time_point time;
+        std::size_t length = 0;
+        char text[text_size];
+    };
+
+    Slot* Claim(std::size_t& position) noexcept
+    {
+        position = head.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot& slot = slots[position & mask];
+            std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+            if (difference == 0)
+            {
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    return &slot;
+            }
+            else if (difference < 0)
+            {
+                return nullptr; // кольцо заполнено
+            }
+            else
+            {
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Забирает все опубликованные записи в один буфер и выводит его одним fwrite
+    bool Drain()
+    {
+        batch.clear();
+        while (true)
+        {
+            Slot& slot = slots[tail & mask];
+            if (slot.sequence.load(std::memory_order_acquire) != tail + 1)
+                break;
+
+            AppendLine(slot);
+            slot.sequence.store(tail + mask + 1, std::memory_order_release);
+            tail++;
+        }
+
+        std::size_t lost = dropped.load(std::memory_order_relaxed);
+        if (lost != reported_dropped)
+        {
+            char line[96];
+            int length = std::snprintf(line, sizeof(line), "level=WARN event=log_dropped count=%zu\n", lost - reported_dropped);
+            batch.append(line, static_cast<std::size_t>(length));
+            reported_dropped = lost;
+        }
+
+        if (batch.empty())
+            return false;
+
+        std::fwrite(batch.data(), 1, batch.size(), output);
+        std::fflush(output);
+        return true;
+    }
+
+    void AppendLine(const Slot& slot)
+    {
+        const auto since_epoch = slot.time.time_since_epoch();
+        const std::time_t seconds = std::chrono::duration_cast<std::chrono::seconds>(since_epoch).count();
+        const int millis = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(since_epoch).count() % 1000);
+
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+
+        char prefix[64];
+        std::size_t length = std::strftime(prefix, sizeof(prefix), "%Y-%m-%dT%H:%M:%S", &local);
+        length += std::snprintf(prefix + length, sizeof(prefix) - length, ".%03d level=%s ", millis, LogLevelName(slot.level));
+
+        batch.append(prefix, length);
+        batch.append(slot.text, slot.length);
+        batch.push_back('\n');
+    }
+
+    void Run()
+    {
+        while (!stopping.load(std::memory_order_acquire))
+        {
+            if (!Drain())
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        Drain();
+    }
+
+private:
+    std::unique_ptr<Slot[]> slots;
+    std::size_t mask = 0;
+
+    alignas(64) std::atomic<std::size_t> head{0};
+    alignas(64) std::size_t tail = 0;
+
+    std::atomic<int> min_level{static_cast<int>(LogLevel::Info)};
+    std::atomic<std::size_t> dropped{0};
+    std::size_t reported_dropped = 0;
+    std::atomic<bool> stopping{false};
+
+    std::FILE* output;
+    std::string batch;
+    std::thread writer;
+};
+
+// Журнал процесса
+inline Logger& Log()
+{
+    static Logger logger;
+    return logger;
+}
+
+#endif
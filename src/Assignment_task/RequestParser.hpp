@@ -0,0 +1,734 @@
+#ifndef REQUEST_PARSER
+#define REQUEST_PARSER
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+#include "Coords.hpp"
+#include "json.hpp"
+
+// Потоковый (SAX) разбор JSON-запроса /run_auction:
+//     {"n": int, "m": int, "robot_coords": [[x, y], ...], "task_coords": [[x, y], ...], "config": {...}}
+// Значения config - числа или списки строк ("solvers": ["auction", "greedy"]).
+// Координаты пишутся сразу в Coords, DOM не строится - нет узла на каждое число.
+// Массивы растут по мере прихода точек. n и m - только подсказка: если они пришли
+// раньше массивов, под точки резервируется не больше, чем может вместить тело
+// запроса (body_size / min_point_bytes на оба массива вместе), а лишняя точка
+// отвергается сразу; итоговое число точек сверяется с n и m в Finish. Так "n": 2000000000 без точек не выделяет
+// память. Форма проверяется по ходу разбора, и разбор останавливается на первой
+// ошибке. Неизвестные ключи верхнего уровня пропускаются, как и раньше.
+//
+// Обработчик подключается к nlohmann::json::sax_parse по соглашению об именах,
+// без наследования от json_sax - так вызовы не виртуальные
+class AuctionRequestSax
+{
+public:
+    using number_integer_t = nlohmann::json::number_integer_t;
+    using number_unsigned_t = nlohmann::json::number_unsigned_t;
+    using number_float_t = nlohmann::json::number_float_t;
+    using string_t = nlohmann::json::string_t;
+    using binary_t = nlohmann::json::binary_t;
+
+    // Самая короткая точка в JSON - "[0,0]," (последняя без запятой)
+    static constexpr std::size_t min_point_bytes = 6;
+
+    AuctionRequestSax(Coords& robots, Coords& tasks, nlohmann::json& config, std::size_t body_size) noexcept
+        : robots(robots), tasks(tasks), config(config), point_budget(body_size / min_point_bytes + 1)
+    {
+    }
+
+    bool null() { return Scalar("null"); }
+    bool boolean(bool) { return Scalar("boolean"); }
+    bool string(string_t& value)
+    {
+        if (skip_depth == 0 && state == State::ConfigList)
+        {
+            config[config_key].push_back(value);
+            return true;
+        }
+        return Scalar("string");
+    }
+    bool binary(binary_t&) { return Scalar("binary"); }
+
+    bool number_integer(number_integer_t value) { return Number(static_cast<double>(value), true, value < 0); }
+    bool number_unsigned(number_unsigned_t value) { return Number(static_cast<double>(value), true, false); }
+    bool number_float(number_float_t value, const string_t&) { return Number(value, false, false); }
+
+    bool start_object(std::size_t)
+    {
+        if (skip_depth > 0)
+            return Skip(+1);
+
+        switch (state)
+        {
+        case State::Start:
+            state = State::TopKey;
+            return true;
+        case State::TopValue:
+            if (field == Field::Config)
+            {
+                config = nlohmann::json::object();
+                state = State::ConfigKey;
+                return true;
+            }
+            if (field == Field::Unknown)
+                return Skip(+1);
+            return Fail("unexpected object");
+        default:
+            return Fail(state == State::ConfigValue ? "config values must be numbers or lists of strings" : "unexpected object");
+        }
+    }
+
+    bool end_object()
+    {
+        if (skip_depth > 0)
+            return Skip(-1);
+
+        if (state == State::ConfigKey)
+        {
+            state = State::TopKey;
+            return true;
+        }
+        if (state == State::TopKey)
+        {
+            state = State::Done;
+            return true;
+        }
+        return Fail("unexpected end of object");
+    }
+
+    bool key(string_t& name)
+    {
+        if (skip_depth > 0)
+            return true;
+
+        if (state == State::ConfigKey)
+        {
+            config_key = name;
+            state = State::ConfigValue;
+            return true;
+        }
+        if (state != State::TopKey)
+            return Fail("unexpected key");
+
+        if (name == "n") field = Field::N;
+        else if (name == "m") field = Field::M;
+        else if (name == "robot_coords") field = Field::Robots;
+        else if (name == "task_coords") field = Field::Tasks;
+        else if (name == "config") field = Field::Config;
+        else field = Field::Unknown;
+
+        state = State::TopValue;
+        return true;
+    }
+
+    bool start_array(std::size_t)
+    {
+        if (skip_depth > 0)
+            return Skip(+1);
+
+        if (state == State::TopValue && (field == Field::Robots || field == Field::Tasks))
+        {
+            Target& target = field == Field::Robots ? robot_target : task_target;
+            if (target.seen)
+                return Fail(FieldName() + " appears twice");
+            target.seen = true;
+            target.count = 0;
+            if (target.expected >= 0)
+            {
+                const std::size_t points = std::min(static_cast<std::size_t>(target.expected), point_budget);
+                target.coords->reserve(points);
+                point_budget -= points;
+            }
+
+            current = &target;
+            state = State::Points;
+            return true;
+        }
+        if (state == State::Points)
+        {
+            if (current->expected >= 0 && current->count >= current->expected)
+                return Fail(FieldName() + " has more entries than declared");
+            component = 0;
+            state = State::Point;
+            return true;
+        }
+        if (state == State::TopValue && field == Field::Unknown)
+            return Skip(+1);
+        if (state == State::ConfigValue)
+        {
+            config[config_key] = nlohmann::json::array();
+            state = State::ConfigList;
+            return true;
+        }
+
+        return Fail(state == State::Point ? "a point must be [x, y]" : "unexpected array");
+    }
+
+    bool end_array()
+    {
+        if (skip_depth > 0)
+            return Skip(-1);
+
+        if (state == State::Point)
+        {
+            if (component != 2)
+                return Fail("a point must be [x, y]");
+            current->count++;
+            state = State::Points;
+            return true;
+        }
+        if (state == State::Points)
+        {
+            current = nullptr;
+            state = State::TopKey;
+            return true;
+        }
+        if (state == State::ConfigList)
+        {
+            state = State::ConfigKey;
+            return true;
+        }
+        return Fail("unexpected end of array");
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e)
+    {
+        error = e.what();
+        return false;
+    }
+
+    // Проверки, которые можно сделать только в конце: n, m заданы и совпадают с массивами
+    void Finish()
+    {
+        if (!error.empty())
+            throw std::invalid_argument(error);
+        if (state != State::Done)
+            throw std::invalid_argument("request must be a JSON object");
+        if (robot_target.expected < 0 || task_target.expected < 0)
+            throw std::invalid_argument("request must contain n and m");
+        if (!robot_target.seen || !task_target.seen)
+            throw std::invalid_argument("request must contain robot_coords and task_coords");
+        if (robot_target.count != robot_target.expected || task_target.count != task_target.expected)
+            throw std::invalid_argument("robot_coords and task_coords must have n and m entries");
+    }
+
+private:
+    enum class State { Start, TopKey, TopValue, Points, Point, ConfigKey, ConfigValue, ConfigList, Done };
+    enum class Field { N, M, Robots, Tasks, Config, Unknown };
+
+    struct Target
+    {
+        Coords* coords;
+        std::int64_t expected = -1; // n или m, если уже известно
+        std::int64_t count = 0;
+        bool seen = false;
+    };
+
+    bool Number(double value, bool integer, bool negative)
+    {
+        if (skip_depth > 0)
+            return true;
+
+        switch (state)
+        {
+        case State::Point:
+        {
+            if (component >= 2)
+                return Fail("a point must be [x, y]");
+
+            Coords& coords = *current->coords;
+            const auto index = static_cast<std::size_t>(current->count);
+            if (component == 0)
+                coords.resize(index + 1);
+
+            (component == 0 ? coords.x : coords.y)[index] = value;
+            component++;
+            return true;
+        }
+        case State::TopValue:
+            if (field == Field::N || field == Field::M)
+            {
+                if (!integer || negative || value > static_cast<double>(INT32_MAX))
+                    return Fail(FieldName() + " must be a non-negative integer");
+                return Declare(field == Field::N ? robot_target : task_target, static_cast<std::int64_t>(value));
+            }
+            if (field == Field::Unknown)
+            {
+                state = State::TopKey;
+                return true;
+            }
+            return Fail(FieldName() + " must be an array of points");
+        case State::ConfigValue:
+            config[config_key] = integer && !negative ? nlohmann::json(static_cast<std::uint64_t>(value)) : nlohmann::json(value);
+            state = State::ConfigKey;
+            return true;
+        case State::ConfigList:
+            return Fail("config lists must contain strings");
+        default:
+            return Fail("unexpected number");
+        }
+    }
+
+    // n или m: память по ним не выделяется, число точек сверяется в Finish
+    bool Declare(Target& target, std::int64_t value)
+    {
+        if (target.expected >= 0)
+            return Fail(FieldName() + " appears twice");
+
+        target.expected = value;
+        state = State::TopKey;
+        return true;
+    }
+
+    bool Scalar(const char* type)
+    {
+        if (skip_depth > 0)
+            return true;
+        if (state == State::TopValue && field == Field::Unknown)
+        {
+            state = State::TopKey;
+            return true;
+        }
+        if (state == State::TopValue && field == Field::Config && std::string_view(type) == "null")
+        {
+            state = State::TopKey;
+            return true;
+        }
+        if (state == State::ConfigValue)
+            return Fail("config values must be numbers or lists of strings");
+        if (state == State::ConfigList)
+            return Fail("config lists must contain strings");
+        return Fail(std::string("unexpected ") + type);
+    }
+
+    // Пропуск значения неизвестного ключа целиком
+    bool Skip(int delta)
+    {
+        skip_depth += delta;
+        if (skip_depth == 0)
+            state = State::TopKey;
+        return true;
+    }
+
+    std::string FieldName() const
+    {
+        switch (field)
+        {
+        case Field::N: return "n";
+        case Field::M: return "m";
+        case Field::Robots: return "robot_coords";
+        case Field::Tasks: return "task_coords";
+        case Field::Config: return "config";
+        default: return "value";
+        }
+    }
+
+    bool Fail(const std::string& message)
+    {
+        error = message;
+        return false;
+    }
+
+private:
+    Coords& robots;
+    Coords& tasks;
+    nlohmann::json& config;
+    std::size_t point_budget; // сколько точек ещё можно зарезервировать по n и m
+
+    Target robot_target{&robots};
+    Target task_target{&tasks};
+    Target* current = nullptr;
+
+    State state = State::Start;
+    Field field = Field::Unknown;
+    int component = 0;
+    int skip_depth = 0;
+    std::string config_key;
+    std::string error;
+};
+
+// Разбор тела запроса; config - объект "config" (null, если его нет).
+// Некорректный запрос - std::invalid_argument
+inline void ParseAuctionRequest(std::string_view body, Coords& robots, Coords& tasks, nlohmann::json& config)
+{
+    config = nullptr;
+    robots.resize(0);
+    tasks.resize(0);
+
+    AuctionRequestSax handler(robots, tasks, config, body.size());
+    nlohmann::json::sax_parse(body, &handler);
+    handler.Finish();
+}
+
+
+// Один экземпляр пакета /run_batch: данные или причина, по которой он не разобран
+struct BatchInstance
+{
+    Coords robots;
+    Coords tasks;
+    nlohmann::json config;
+    std::string error;
+};
+
+// Потоковый разбор пакета /run_batch:
+//     {"instances": [{...как /run_auction...}, ...], "config": {...}, "order": "completion" | "input"}
+// Каждый элемент instances разбирается тем же AuctionRequestSax: события пересылаются
+// ему, пока элемент не закроется. Ошибка в элементе не останавливает разбор - она
+// записывается в BatchInstance::error, а остаток элемента пропускается, и память
+// элемента освобождается. Резерв по n и m у элемента - только из той части тела,
+// которую не заняли уже принятые экземпляры, так что пакет из множества
+// {"n": 2000000000, ...} не выделит больше, чем вмещает тело.
+// "config" пакета - значения по умолчанию для "config" экземпляров
+class BatchRequestSax
+{
+public:
+    using number_integer_t = nlohmann::json::number_integer_t;
+    using number_unsigned_t = nlohmann::json::number_unsigned_t;
+    using number_float_t = nlohmann::json::number_float_t;
+    using string_t = nlohmann::json::string_t;
+    using binary_t = nlohmann::json::binary_t;
+
+    BatchRequestSax(std::vector<BatchInstance>& instances, nlohmann::json& config, std::string& order,
+                    std::size_t body_size) noexcept
+        : instances(instances), config(config), order(order), body_size(body_size)
+    {
+    }
+
+    bool null()
+    {
+        if (state == State::Instance)
+            return Forward([](AuctionRequestSax& sax) { return sax.null(); }, 0);
+        return Scalar("null");
+    }
+
+    bool boolean(bool value)
+    {
+        if (state == State::Instance)
+            return Forward([&](AuctionRequestSax& sax) { return sax.boolean(value); }, 0);
+        return Scalar("boolean");
+    }
+
+    bool binary(binary_t& value)
+    {
+        if (state == State::Instance)
+            return Forward([&](AuctionRequestSax& sax) { return sax.binary(value); }, 0);
+        return Scalar("binary");
+    }
+
+    bool string(string_t& value)
+    {
+        if (state == State::Instance)
+            return Forward([&](AuctionRequestSax& sax) { return sax.string(value); }, 0);
+        if (skip_depth == 0 && state == State::TopValue && field == Field::Order)
+        {
+            if (value != "completion" && value != "input")
+                return Fail("order must be \"completion\" or \"input\"");
+            order = value;
+            state = State::TopKey;
+            return true;
+        }
+        if (skip_depth == 0 && state == State::ConfigList)
+        {
+            config[config_key].push_back(value);
+            return true;
+        }
+        return Scalar("string");
+    }
+
+    bool number_integer(number_integer_t value)
+    {
+        if (state == State::Instance)
+            return Forward([&](AuctionRequestSax& sax) { return sax.number_integer(value); }, 0);
+        return Number(static_cast<double>(value), value >= 0);
+    }
+
+    bool number_unsigned(number_unsigned_t value)
+    {
+        if (state == State::Instance)
+            return Forward([&](AuctionRequestSax& sax) { return sax.number_unsigned(value); }, 0);
+        return Number(static_cast<double>(value), true);
+    }
+
+    bool number_float(number_float_t value, const string_t& text)
+    {
+        if (state == State::Instance)
+            return Forward([&](AuctionRequestSax& sax) { return sax.number_float(value, text); }, 0);
+        return Number(value, false);
+    }
+
+    bool start_object(std::size_t size)
+    {
+        if (state == State::Instances)
+            Begin();
+        if (state == State::Instance)
+            return Forward([&](AuctionRequestSax& sax) { return sax.start_object(size); }, +1);
+        if (skip_depth > 0)
+            return Skip(+1);
+
+        switch (state)
+        {
+        case State::Start:
+            state = State::TopKey;
+            return true;
+        case State::TopValue:
+            if (field == Field::Config)
+            {
+                config = nlohmann::json::object();
+                state = State::ConfigKey;
+                return true;
+            }
+            if (field == Field::Unknown)
+                return Skip(+1);
+            return Fail("unexpected object");
+        default:
+            return Fail(state == State::ConfigValue ? "config values must be numbers or lists of strings" : "unexpected object");
+        }
+    }
+
+    bool end_object()
+    {
+        if (state == State::Instance)
+            return Forward([](AuctionRequestSax& sax) { return sax.end_object(); }, -1);
+        if (skip_depth > 0)
+            return Skip(-1);
+
+        if (state == State::ConfigKey || state == State::TopKey)
+        {
+            state = state == State::ConfigKey ? State::TopKey : State::Done;
+            return true;
+        }
+        return Fail("unexpected end of object");
+    }
+
+    bool key(string_t& name)
+    {
+        if (state == State::Instance)
+            return Forward([&](AuctionRequestSax& sax) { return sax.key(name); }, 0);
+        if (skip_depth > 0)
+            return true;
+
+        if (state == State::ConfigKey)
+        {
+            config_key = name;
+            state = State::ConfigValue;
+            return true;
+        }
+        if (state != State::TopKey)
+            return Fail("unexpected key");
+
+        if (name == "instances") field = Field::Instances;
+        else if (name == "config") field = Field::Config;
+        else if (name == "order") field = Field::Order;
+        else field = Field::Unknown;
+
+        state = State::TopValue;
+        return true;
+    }
+
+    bool start_array(std::size_t size)
+    {
+        if (state == State::Instances)
+            Begin();
+        if (state == State::Instance)
+            return Forward([&](AuctionRequestSax& sax) { return sax.start_array(size); }, +1);
+        if (skip_depth > 0)
+            return Skip(+1);
+
+        if (state == State::TopValue && field == Field::Instances)
+        {
+            if (instances_seen)
+                return Fail("instances appears twice");
+            instances_seen = true;
+            if (size != static_cast<std::size_t>(-1))
+                instances.reserve(size);
+            state = State::Instances;
+            return true;
+        }
+        if (state == State::TopValue && field == Field::Unknown)
+            return Skip(+1);
+        if (state == State::ConfigValue)
+        {
+            config[config_key] = nlohmann::json::array();
+            state = State::ConfigList;
+            return true;
+        }
+
+        return Fail("unexpected array");
+    }
+
+    bool end_array()
+    {
+        if (state == State::Instance)
+            return Forward([](AuctionRequestSax& sax) { return sax.end_array(); }, -1);
+        if (skip_depth > 0)
+            return Skip(-1);
+
+        if (state == State::Instances)
+        {
+            state = State::TopKey;
+            return true;
+        }
+        if (state == State::ConfigList)
+        {
+            state = State::ConfigKey;
+            return true;
+        }
+        return Fail("unexpected end of array");
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e)
+    {
+        error = e.what();
+        return false;
+    }
+
+    void Finish()
+    {
+        if (!error.empty())
+            throw std::invalid_argument(error);
+        if (state != State::Done)
+            throw std::invalid_argument("request must be a JSON object");
+        if (!instances_seen)
+            throw std::invalid_argument("request must contain instances");
+    }
+
+private:
+    enum class State { Start, TopKey, TopValue, ConfigKey, ConfigValue, ConfigList, Instances, Instance, Done };
+    enum class Field { Instances, Config, Order, Unknown };
+
+    // Новый элемент instances; скаляр вместо объекта сразу становится ошибкой элемента
+    void Begin()
+    {
+        instances.emplace_back();
+        BatchInstance& instance = instances.back();
+        instance_sax.emplace(instance.robots, instance.tasks, instance.config,
+                             body_size - std::min(kept_bytes, body_size));
+        instance_failed = false;
+        depth = 0;
+        state = State::Instance;
+    }
+
+    // Событие внутри элемента; после первой ошибки элемент только досчитывается до конца
+    template<typename Call>
+    bool Forward(Call call, int delta)
+    {
+        if (!instance_failed && !call(*instance_sax))
+            instance_failed = true;
+
+        depth += delta;
+        if (depth == 0)
+            End();
+        return true;
+    }
+
+    void End()
+    {
+        BatchInstance& instance = instances.back();
+        try
+        {
+            instance_sax->Finish();
+            kept_bytes += (instance.robots.size() + instance.tasks.size()) * AuctionRequestSax::min_point_bytes;
+        }
+        catch (const std::invalid_argument& e)
+        {
+            instance = BatchInstance();
+            instance.error = e.what();
+        }
+
+        instance_sax.reset();
+        state = State::Instances;
+    }
+
+    bool Number(double value, bool unsigned_integer)
+    {
+        if (skip_depth > 0)
+            return true;
+
+        if (state == State::ConfigValue)
+        {
+            config[config_key] = unsigned_integer ? nlohmann::json(static_cast<std::uint64_t>(value)) : nlohmann::json(value);
+            state = State::ConfigKey;
+            return true;
+        }
+        return Scalar("number");
+    }
+
+    bool Scalar(const char* type)
+    {
+        if (skip_depth > 0)
+            return true;
+        if (state == State::Instances)
+        {
+            instances.emplace_back();
+            instances.back().error = "instance must be a JSON object";
+            return true;
+        }
+        if (state == State::TopValue && (field == Field::Unknown ||
+                                         (field == Field::Config && std::string_view(type) == "null")))
+        {
+            state = State::TopKey;
+            return true;
+        }
+        if (state == State::ConfigValue)
+            return Fail("config values must be numbers or lists of strings");
+        if (state == State::ConfigList)
+            return Fail("config lists must contain strings");
+        if (state == State::TopValue && field == Field::Order)
+            return Fail("order must be \"completion\" or \"input\"");
+        return Fail(std::string("unexpected ") + type);
+    }
+
+    bool Skip(int delta)
+    {
+        skip_depth += delta;
+        if (skip_depth == 0)
+            state = State::TopKey;
+        return true;
+    }
+
+    bool Fail(const std::string& message)
+    {
+        error = message;
+        return false;
+    }
+
+private:
+    std::vector<BatchInstance>& instances;
+    nlohmann::json& config;
+    std::string& order;
+    std::size_t body_size;
+    std::size_t kept_bytes = 0; // минимальный объём тела под точки принятых экземпляров
+
+    std::optional<AuctionRequestSax> instance_sax;
+    bool instance_failed = false;
+    int depth = 0;
+
+    State state = State::Start;
+    Field field = Field::Unknown;
+    bool instances_seen = false;
+    int skip_depth = 0;
+    std::string config_key;
+    std::string error;
+};
+
+// Разбор тела пакета; order - "completion" (по умолчанию) или "input".
+// Синтаксическая ошибка JSON или неверная форма пакета - std::invalid_argument
+inline void ParseBatchRequest(std::string_view body, std::vector<BatchInstance>& instances,
+                              nlohmann::json& config, std::string& order)
+{
+    instances.clear();
+    config = nullptr;
+    order = "completion";
+
+    BatchRequestSax handler(instances, config, order, body.size());
+    nlohmann::json::sax_parse(body, &handler);
+    handler.Finish();
+}
+
+#endif
@@ -0,0 +1,306 @@
+#ifndef RESULT_CACHE
+#define RESULT_CACHE
+
+#include <list>
+#include <mutex>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <unordered_map>
+
+// Ключ кэша: каноническое представление запроса (байты) и его 64-битный хэш.
+// Хэш только выбирает корзину - равенство проверяется по байтам целиком,
+// поэтому коллизия не может вернуть чужой результат
+struct CacheKey
+{
+    std::uint64_t hash = 0;
+    std::string bytes;
+
+    bool operator==(const CacheKey& other) const noexcept
+    {
+        return hash == other.hash && bytes == other.bytes;
+    }
+};
+
+struct CacheKeyHash
+{
+    std::size_t operator()(const CacheKey& key) const noexcept { return static_cast<std::size_t>(key.hash); }
+};
+
+// Сборка ключа: значения дописываются в фиксированном порядке, числа - побитно.
+// -0.0 приводится к 0.0, чтобы равные координаты давали равные ключи
+class CacheKeyBuilder
+{
+public:
+    CacheKeyBuilder& Add(std::uint64_t value)
+    {
+        Append(&value, sizeof(value));
+        return *this;
+    }
+
+    CacheKeyBuilder& Add(double value)
+    {
+        if (value == 0.0)
+            value = 0.0;
+        Append(&value, sizeof(value));
+        return *this;
+    }
+
+    CacheKeyBuilder& Add(const std::vector<double>& values)
+    {
+        Add(static_cast<std::uint64_t>(values.size()));
+        const std::size_t offset = bytes.size();
+        Append(values.data(), values.size() * sizeof(double));
+
+        // Нули нормализуются уже в буфере: отдельного прохода с копией нет
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            if (values[i] == 0.0)
+            {
+                const double zero = 0.0;
+                std::memcpy(&bytes[offset + i * sizeof(double)], &zero, sizeof(double));
+            }
+        }
+        return *this;
+    }
+
+    [[nodiscard]] CacheKey Build()
+    {
+        CacheKey key;
+        key.hash = Hash(bytes);
+        key.bytes = std::move(bytes);
+        bytes.clear();
+        return key;
+    }
+
+    // Хэш по 8-байтовым словам с перемешиванием умножением и финализатором splitmix64
+    static std::uint64_t Hash(const std::string& data) noexcept
+    {
+        std::uint64_t h = 0x9E3779B97F4A7C15ull ^ data.size();
+        std::size_t i = 0;
+        for (; i + 8 <= data.size(); i += 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, data.data() + i, 8);
+            h = (h ^ Mix(word)) * 0xFF51AFD7ED558CCDull;
+            h ^= h >> 29;
+        }
+
+        std::uint64_t tail = 0;
+        std::memcpy(&tail, data.data() + i, data.size() - i);
+        return Mix(h ^ Mix(tail));
+    }
+
+private:
+    static std::uint64_t Mix(std::uint64_t x) noexcept
+    {
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ull;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBull;
+        x ^= x >> 31;
+        return x;
+    }
+
+    void Append(const void* data, std::size_t size)
+    {
+        bytes.append(static_cast<const char*>(data), size);
+    }
+
+private:
+    std::string bytes;
+};
+
+
+enum class CacheOutcome
+{
+    Hit,     // готовый результат из кэша
+    Joined,  // такой же запрос уже решается - ждём его результат
+    Miss     // решаем сами
+};
+
+struct CacheStats
+{
+    std::size_t entries = 0;
+    std::size_t bytes = 0;
+    std::size_t hits = 0;
+    std::size_t joined = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+    std::size_t expirations = 0;
+};
+
+// LRU-кэш результатов с ограничением по байтам и временем жизни записи.
+// Одновременные одинаковые запросы решаются один раз (single-flight): первый
+// вычисляет результат, остальные получают тот же shared_future. Ошибки не
+// кэшируются - исключение получают все ожидающие, следующий запрос решает заново.
+// max_bytes = 0 отключает хранение, но не объединение одновременных запросов.
+template<typename Value>
+class ResultCache
+{
+public:
+    using Result = std::shared_ptr<const Value>;
+    using SizeOf = std::function<std::size_t(const Value&)>;
+
+    ResultCache(std::size_t max_bytes, std::chrono::milliseconds ttl, SizeOf size_of)
+        : max_bytes(max_bytes), ttl(ttl), size_of(std::move(size_of))
+    {
+    }
+
+    // compute() выполняется в вызывающем потоке, только если результата нет
+    // ни в кэше, ни в работе
+    template<typename F>
+    std::shared_future<Result> Get(const CacheKey& key, F&& compute, CacheOutcome& outcome)
+    {
+        std::promise<Result> promise;
+        std::shared_future<Result> future;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto it = index.find(key);
+            if (it != index.end())
+            {
+                if (Clock::now() - it->second->stored <= ttl)
+                {
+                    entries.splice(entries.begin(), entries, it->second);
+                    hits++;
+                    outcome = CacheOutcome::Hit;
+                    return Ready(it->second->value);
+                }
+
+                expirations++;
+                Erase(it);
+            }
+
+            auto flight = in_flight.find(key);
+            if (flight != in_flight.end())
+            {
+                joined++;
+                outcome = CacheOutcome::Joined;
+                return flight->second;
+            }
+
+            misses++;
+            outcome = CacheOutcome::Miss;
+            future = promise.get_future().share();
+            in_flight.emplace(key, future);
+        }
+
+        Result result;
+        try
+        {
+            result = std::make_shared<const Value>(compute());
+        }
+        catch (...)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                in_flight.erase(key);
+            }
+            promise.set_exception(std::current_exception());
+            return future;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            in_flight.erase(key);
+            Store(key, result);
+        }
+        promise.set_value(result);
+        return future;
+    }
+
+    [[nodiscard]] CacheStats Stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        CacheStats stats;
+        stats.entries = entries.size();
+        stats.bytes = bytes;
+        stats.hits = hits;
+        stats.joined = joined;
+        stats.misses = misses;
+        stats.evictions = evictions;
+        stats.expirations = expirations;
+        return stats;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry
+    {
+        CacheKey key;
+        Result value;
+        std::size_t size;
+        Clock::time_point stored;
+    };
+
+    using EntryList = std::list<Entry>;
+    using Index = std::unordered_map<CacheKey, typename EntryList::iterator, CacheKeyHash>;
+
+    static std::shared_future<Result> Ready(const Result& value)
+    {
+        std::promise<Result> promise;
+        promise.set_value(value);
+        return promise.get_future().share();
+    }
+
+    // Ключ хранится дважды (в индексе и в записи) - это учитывается в размере
+    void Store(const CacheKey& key, const Result& value)
+    {
+        const std::size_t size = size_of(*value) + 2 * (sizeof(Entry) + key.bytes.size());
+        if (size > max_bytes)
+            return;
+
+        auto existing = index.find(key);
+        if (existing != index.end())
+            Erase(existing);
+
+        const Clock::time_point now = Clock::now();
+        while (!entries.empty() && (bytes + size > max_bytes || now - entries.back().stored > ttl))
+        {
+            if (now - entries.back().stored > ttl)
+                expirations++;
+            else
+                evictions++;
+            Erase(index.find(entries.back().key));
+        }
+
+        entries.push_front({key, value, size, now});
+        index.emplace(key, entries.begin());
+        bytes += size;
+    }
+
+    void Erase(typename Index::iterator it)
+    {
+        bytes -= it->second->size;
+        entries.erase(it->second);
+        index.erase(it);
+    }
+
+private:
+    const std::size_t max_bytes;
+    const std::chrono::milliseconds ttl;
+    const SizeOf size_of;
+
+    mutable std::mutex mutex;
+    EntryList entries;
+    Index index;
+    std::unordered_map<CacheKey, std::shared_future<Result>, CacheKeyHash> in_flight;
+
+    std::size_t bytes = 0;
+    std::size_t hits = 0;
+    std::size_t joined = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+    std::size_t expirations = 0;
+};
+
+#endif
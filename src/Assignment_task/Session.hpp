@@ -0,0 +1,450 @@
+#ifndef PLANNING_SESSION
+#define PLANNING_SESSION
+
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "Coords.hpp"
+#include "SolverConfig.hpp"
+#include "AuctionAlgo.hpp"
+#include "GreedyAlgo.hpp"
+#include "SmallAssignment.hpp"
+#include "UtilityKernel.hpp"
+#include "UtilityOracle.hpp"
+#include "ComponentLabeler.hpp"
+
+// Изменения сессии между решениями. Индексы задач в remove_tasks относятся к списку
+// до изменения; после удаления оставшиеся задачи сдвигаются к началу без смены
+// порядка, а add_tasks дописываются в конец
+struct SessionUpdate
+{
+    std::vector<int> moved_robots;
+    Coords moved_to;
+    std::vector<int> remove_tasks;
+    Coords add_tasks;
+};
+
+// Что сделало последнее решение аукциона
+struct SessionSolveStats
+{
+    std::size_t components = 0;
+    std::size_t reused = 0;  // компонента не изменилась - решение взято целиком
+    std::size_t warm = 0;    // доторговывались от прошлых цен
+    std::size_t cold = 0;
+    std::size_t moved = 0;   // роботов сдвинуто с прошлого решения
+    bool tasks_changed = false;
+    bool relabeled = false;
+};
+
+// Сессия планирования: роботы и задачи живут на сервере, клиент присылает только
+// изменения. Между решениями сохраняются:
+//  - матрица полезностей (если n * m <= max_exact_cells) - при движении робота
+//    пересчитывается его строка, при изменении задач - столбцы;
+//  - компоненты видимости - перестраиваются, только если роботы двигались;
+//  - цены и назначения аукциона по компонентам - следующее решение стартует с них.
+//    Компонента, которую изменения не задели, не переторговывается вовсе.
+// Методы не потокобезопасны: вызывающий держит Mutex()
+class PlanningSession
+{
+public:
+    using Auction = AuctionAlgo<double>;
+
+    PlanningSession(Coords robots, Coords tasks, const SolverConfig& config)
+        : robots(std::move(robots)), tasks(std::move(tasks)), config(config)
+    {
+        moved.assign(this->robots.size(), false);
+        last_assignment.assign(this->robots.size(), -1);
+    }
+
+    PlanningSession(const PlanningSession&) = delete;
+    PlanningSession& operator=(const PlanningSession&) = delete;
+
+    [[nodiscard]] std::mutex& Mutex() noexcept { return mutex; }
+
+    [[nodiscard]] const Coords& Robots() const noexcept { return robots; }
+    [[nodiscard]] const Coords& Tasks() const noexcept { return tasks; }
+    [[nodiscard]] const SolverConfig& Config() const noexcept { return config; }
+    // Матрица хранится, если помещается; строится при первом решении в потоке пула
+    [[nodiscard]] bool Dense() const noexcept { return FitsMatrix(); }
+    [[nodiscard]] const SessionSolveStats& LastSolve() const noexcept { return stats; }
+
+    // Изменение применяется целиком или не применяется: сначала проверка, потом правка.
+    // Некорректное изменение - std::invalid_argument
+    void Apply(const SessionUpdate& update)
+    {
+        const std::size_t n = robots.size();
+        const std::size_t m = tasks.size();
+
+        if (update.moved_robots.size() != update.moved_to.size())
+            throw std::invalid_argument("moved robots and their coordinates differ in length");
+        for (int robot : update.moved_robots)
+        {
+            if (robot < 0 || static_cast<std::size_t>(robot) >= n)
+                throw std::invalid_argument("robot index out of range: " + std::to_string(robot));
+        }
+
+        std::vector<int> task_map(m);
+        for (std::size_t j = 0; j < m; ++j)
+            task_map[j] = static_cast<int>(j);
+        for (int task : update.remove_tasks)
+        {
+            if (task < 0 || static_cast<std::size_t>(task) >= m)
+                throw std::invalid_argument("task index out of range: " + std::to_string(task));
+            task_map[task] = -1;
+        }
+
+        if (!update.remove_tasks.empty())
+            RemoveTasks(task_map);
+        if (update.add_tasks.size() > 0)
+            AddTasks(update.add_tasks);
+
+        for (std::size_t k = 0; k < update.moved_robots.size(); ++k)
+            MoveRobot(update.moved_robots[k], update.moved_to.x[k], update.moved_to.y[k]);
+    }
+
+    // Аукцион с тёплым стартом от прошлого решения. threads - сколько потоков можно
+    // занять под компоненты и построение матрицы
+    double SolveAuction(std::vector<int>& assignment, std::size_t threads)
+    {
+        const int n = static_cast<int>(robots.size());
+        const int m = static_cast<int>(tasks.size());
+
+        stats = SessionSolveStats();
+        stats.tasks_changed = tasks_changed;
+        stats.moved = static_cast<std::size_t>(std::count(moved.begin(), moved.end(), true));
+
+        // Без движения роботов компоненты те же
+        Components previous;
+        stats.relabeled = !labeled || stats.moved > 0;
+        if (stats.relabeled)
+        {
+            previous = std::move(components);
+            LabelComponents(robots, config.visibility_radius, components, threads);
+        }
+
+        std::vector<Auction::ComponentState> next = WarmStates(stats.relabeled ? previous : components);
+
+        Auction auction;
+        double utility;
+        EnsureMatrix(threads);
+        if (HasMatrix())
+        {
+            utility = auction.Start(n, m, DenseUtility<double>(matrix), components, config.epsilon, next, assignment);
+        }
+        else
+        {
+            UtilityOracle oracle(robots, tasks, config.max_utility, config.distance_offset);
+            if (m > 0)
+                oracle.SetCache(1, std::max<std::size_t>(1, config.oracle_cache_bytes / (sizeof(double) * m)));
+            utility = auction.Start(n, m, oracle, components, config.epsilon, next, assignment);
+        }
+
+        states = std::move(next);
+        last_assignment = assignment;
+        component_of.assign(n, -1);
+        for (std::size_t c = 0; c < components.size(); ++c)
+            for (const int* robot = components.begin(c); robot != components.end(c); ++robot)
+                component_of[*robot] = static_cast<int>(c);
+
+        std::fill(moved.begin(), moved.end(), false);
+        tasks_changed = false;
+        labeled = true;
+        stats.components = components.size();
+        return utility;
+    }
+
+    double SolveGreedy(std::vector<int>& assignment) const
+    {
+        const int n = static_cast<int>(robots.size());
+        const int m = static_cast<int>(tasks.size());
+
+        GreedyAlgo<double> greedy;
+        if (HasMatrix())
+            return greedy.Start(n, m, DenseUtility<double>(matrix), assignment);
+
+        UtilityOracle oracle(robots, tasks, config.max_utility, config.distance_offset);
+        return greedy.Start(n, m, oracle, assignment);
+    }
+
+    // Точное решение по сохранённой матрице; false - матрица слишком велика
+    bool SolveExact(std::vector<int>& assignment, double& utility, std::size_t threads)
+    {
+        EnsureMatrix(threads);
+        if (!HasMatrix())
+            return false;
+
+        utility = SolveAssignmentExact(static_cast<int>(robots.size()), static_cast<int>(tasks.size()), matrix, assignment);
+        return true;
+    }
+
+private:
+    [[nodiscard]] bool FitsMatrix() const noexcept
+    {
+        return robots.size() * tasks.size() <= config.max_exact_cells;
+    }
+
+    [[nodiscard]] bool HasMatrix() const noexcept
+    {
+        return FitsMatrix() && matrix.size() == robots.size();
+    }
+
+    // Матрица строится заново, только когда снова поместилась после роста числа задач
+    void EnsureMatrix(std::size_t threads)
+    {
+        if (!FitsMatrix())
+        {
+            matrix.clear();
+            matrix.shrink_to_fit();
+        }
+        else if (matrix.size() != robots.size())
+        {
+            UtilityKernel::FillMatrix(robots, tasks, config.max_utility, config.distance_offset, matrix, threads);
+        }
+    }
+
+    void FillRow(std::size_t i, std::size_t first_task, double* out) const noexcept
+    {
+        UtilityKernel::FillRow(robots.x[i], robots.y[i], tasks.x.data() + first_task, tasks.y.data() + first_task,
+                               tasks.size() - first_task, config.max_utility, config.distance_offset, out, false);
+    }
+
+    void MoveRobot(int robot, double x, double y)
+    {
+        robots.Set(robot, x, y);
+        moved[robot] = true;
+        if (!matrix.empty())
+            FillRow(robot, 0, matrix[robot].data());
+    }
+
+    // task_map[j] - новый номер задачи j или -1, если она удалена
+    void RemoveTasks(std::vector<int>& task_map)
+    {
+        int next = 0;
+        for (int& target : task_map)
+            target = target < 0 ? -1 : next++;
+
+        auto compact = [&](auto& values) {
+            std::size_t out = 0;
+            for (std::size_t j = 0; j < task_map.size(); ++j)
+                if (task_map[j] >= 0)
+                    values[out++] = values[j];
+            values.resize(out);
+        };
+
+        compact(tasks.x);
+        compact(tasks.y);
+        for (std::vector<double>& row : matrix)
+            compact(row);
+
+        // Прошлые решения переводятся на новые номера задач
+        for (Auction::ComponentState& state : states)
+        {
+            if (!state.prices.empty())
+                compact(state.prices);
+            for (int& task : state.assignment)
+                task = task < 0 ? -1 : task_map[task];
+        }
+        for (int& task : last_assignment)
+            task = task < 0 ? -1 : task_map[task];
+
+        tasks_changed = true;
+    }
+
+    void AddTasks(const Coords& added)
+    {
+        const std::size_t first = tasks.size();
+        tasks.x.insert(tasks.x.end(), added.x.begin(), added.x.end());
+        tasks.y.insert(tasks.y.end(), added.y.begin(), added.y.end());
+
+        if (!FitsMatrix())
+        {
+            matrix.clear();
+            matrix.shrink_to_fit();
+        }
+        for (std::size_t i = 0; i < matrix.size(); ++i)
+        {
+            matrix[i].resize(tasks.size());
+            FillRow(i, first, matrix[i].data() + first);
+        }
+
+        // Новые задачи начинают торги с нулевой цены
+        for (Auction::ComponentState& state : states)
+        {
+            if (!state.prices.empty())
+                state.prices.resize(tasks.size(), 0.0);
+        }
+
+        tasks_changed = true;
+    }
+
+    // Начальное состояние аукциона для текущих компонент. Компонента наследует цены той
+    // прошлой компоненты, откуда пришло большинство её роботов, а назначения - у каждого
+    // робота свои. Если состав компоненты тот же, никто не двигался и задачи не менялись,
+    // прошлое решение переиспользуется целиком
+    std::vector<Auction::ComponentState> WarmStates(const Components& previous)
+    {
+        std::vector<Auction::ComponentState> result(components.size());
+        if (states.empty())
+        {
+            stats.cold = components.size();
+            return result;
+        }
+
+        std::vector<std::size_t> votes(states.size(), 0);
+        std::vector<int> touched;
+
+        for (std::size_t c = 0; c < components.size(); ++c)
+        {
+            const int* begin = components.begin(c);
+            const int* end = components.end(c);
+            Auction::ComponentState& state = result[c];
+
+            int source = -1;
+            bool untouched = !tasks_changed;
+            for (const int* robot = begin; robot != end; ++robot)
+            {
+                const int old = component_of[*robot];
+                untouched = untouched && !moved[*robot] && old == component_of[*begin];
+                if (old < 0)
+                    continue;
+                if (votes[old]++ == 0)
+                    touched.push_back(old);
+                if (source < 0 || votes[old] > votes[source])
+                    source = old;
+            }
+            for (int old : touched)
+                votes[old] = 0;
+            touched.clear();
+
+            if (source >= 0 && untouched && previous.size(source) == components.size(c))
+            {
+                state = states[source];
+                state.reuse = true;
+                stats.reused++;
+                continue;
+            }
+
+            if (source >= 0)
+            {
+                state.prices = states[source].prices;
+                state.assignment.resize(end - begin);
+                for (const int* robot = begin; robot != end; ++robot)
+                    state.assignment[robot - begin] = last_assignment[*robot];
+            }
+            (state.prices.empty() ? stats.cold : stats.warm)++;
+        }
+        return result;
+    }
+
+private:
+    std::mutex mutex;
+
+    Coords robots;
+    Coords tasks;
+    const SolverConfig config;
+
+    // Полезности n x m; пусто, если матрица не помещается в max_exact_cells или ещё не решали
+    std::vector<std::vector<double>> matrix;
+
+    // Прошлое решение
+    Components components;
+    bool labeled = false;
+    std::vector<int> component_of;
+    std::vector<Auction::ComponentState> states;
+    std::vector<int> last_assignment;
+
+    // Изменения с прошлого решения
+    std::vector<bool> moved;
+    bool tasks_changed = false;
+
+    SessionSolveStats stats;
+};
+
+
+// Реестр сессий. Сессия, к которой не обращались дольше idle_ttl, удаляется при
+// следующем создании; число сессий ограничено, чтобы клиенты не исчерпали память
+class SessionStore
+{
+public:
+    SessionStore(std::size_t max_sessions, std::chrono::milliseconds idle_ttl)
+        : max_sessions(max_sessions), idle_ttl(idle_ttl), generator(std::random_device{}())
+    {
+    }
+
+    // Пустой id - сессий уже max_sessions
+    std::string Create(std::shared_ptr<PlanningSession> session)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        const Clock::time_point now = Clock::now();
+        for (auto it = sessions.begin(); it != sessions.end();)
+        {
+            if (now - it->second.last_used > idle_ttl)
+                it = sessions.erase(it);
+            else
+                ++it;
+        }
+        if (sessions.size() >= max_sessions)
+            return {};
+
+        std::string id;
+        do
+        {
+            char buffer[17];
+            std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(generator()));
+            id = buffer;
+        } while (sessions.count(id) > 0);
+
+        sessions[id] = {std::move(session), now};
+        return id;
+    }
+
+    [[nodiscard]] std::shared_ptr<PlanningSession> Find(const std::string& id)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto it = sessions.find(id);
+        if (it == sessions.end())
+            return nullptr;
+        it->second.last_used = Clock::now();
+        return it->second.session;
+    }
+
+    bool Erase(const std::string& id)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return sessions.erase(id) > 0;
+    }
+
+    [[nodiscard]] std::size_t Size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return sessions.size();
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry
+    {
+        std::shared_ptr<PlanningSession> session;
+        Clock::time_point last_used;
+    };
+
+    const std::size_t max_sessions;
+    const std::chrono::milliseconds idle_ttl;
+
+    mutable std::mutex mutex;
+    std::mt19937_64 generator;
+    std::unordered_map<std::string, Entry> sessions;
+};
+
+#endif
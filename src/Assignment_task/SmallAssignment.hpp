@@ -0,0 +1,272 @@
+#ifndef SMALL_ASSIGNMENT
+#define SMALL_ASSIGNMENT
+
+#include <vector>
+#include <array>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#include "HungarianAlgo.hpp"
+
+// Точное решение задачи о назначениях для маленьких экземпляров (max(n, m) <= N).
+// Все рабочие массивы имеют фиксированный размер, известный на этапе компиляции,
+// и не выделяются в куче:
+//  - N <= 5  - перебор размещений с отсечением по сумме максимумов оставшихся строк,
+//              развёрнутый шаблонной рекурсией;
+//  - N <= 16 - венгерский алгоритм (кратчайшие увеличивающие пути) на std::array.
+// Перебор при n = 6 и динамика по подмножествам O(2^n * n) уже при n = 8 в несколько
+// раз медленнее венгерского алгоритма O(n^3) на фиксированных массивах.
+// Как и HungarianAlgo, максимизирует суммарную полезность по min(n, m) парам.
+template<std::size_t N, typename T = double>
+class SmallAssignment
+{
+    static_assert(N > 0 && N <= 16, "SmallAssignment supports up to 16 rows or columns");
+
+public:
+    static constexpr std::size_t max_size = N;
+    static constexpr std::size_t max_brute_force = 5;
+
+    T Start(int n, int m, const std::vector<std::vector<T>>& alpha, std::vector<int>& assignment)
+    {
+        if (n < 0 || m < 0 || static_cast<std::size_t>(std::max(n, m)) > N)
+        {
+            throw std::invalid_argument("Instance is too large for SmallAssignment");
+        }
+
+        assignment.assign(n, -1);
+        if (n == 0 || m == 0)
+            return T(0);
+
+        // Меньшая сторона - строки, большая - столбцы
+        transposed = n > m;
+        rows = transposed ? m : n;
+        cols = transposed ? n : m;
+
+        for (std::size_t r = 0; r < rows; ++r)
+        {
+            for (std::size_t c = 0; c < cols; ++c)
+            {
+                weight[r * N + c] = transposed ? alpha[c][r] : alpha[r][c];
+            }
+        }
+
+        T best;
+        if constexpr (N <= max_brute_force)
+            best = BruteForce();
+        else
+            best = ShortestPath();
+
+        for (std::size_t r = 0; r < rows; ++r)
+        {
+            if (transposed)
+                assignment[best_pick[r]] = static_cast<int>(r);
+            else
+                assignment[r] = static_cast<int>(best_pick[r]);
+        }
+        return best;
+    }
+
+private:
+    T BruteForce()
+    {
+        // bound[r] - сумма максимумов строк r..rows-1, верхняя оценка остатка
+        bound[rows] = T(0);
+        for (std::size_t r = rows; r-- > 0;)
+        {
+            const T* w = &weight[r * N];
+            bound[r] = bound[r + 1] + *std::max_element(w, w + cols);
+        }
+
+        best_value = std::numeric_limits<T>::lowest();
+        Search<0>(0u, T(0));
+        return best_value;
+    }
+
+    // Глубина рекурсии известна на этапе компиляции, поэтому цикл по уровням разворачивается
+    template<std::size_t Depth>
+    void Search(std::uint32_t used, T acc)
+    {
+        if (Depth == rows)
+        {
+            if (acc > best_value)
+            {
+                best_value = acc;
+                std::copy_n(pick.begin(), rows, best_pick.begin());
+            }
+            return;
+        }
+
+        if constexpr (Depth < N)
+        {
+            if (acc + bound[Depth] <= best_value)
+                return;
+
+            const T* w = &weight[Depth * N];
+            for (std::size_t c = 0; c < cols; ++c)
+            {
+                if (used & (1u << c))
+                    continue;
+
+                pick[Depth] = static_cast<std::uint8_t>(c);
+                Search<Depth + 1>(used | (1u << c), acc + w[c]);
+            }
+        }
+    }
+
+    // Тот же алгоритм, что в HungarianAlgo, но на стоимостях -weight и без выделений памяти
+    T ShortestPath()
+    {
+        const T INF = std::numeric_limits<T>::max();
+
+        std::fill_n(u.begin(), rows + 1, T(0));
+        std::fill_n(v.begin(), cols + 1, T(0));
+        std::fill_n(p.begin(), cols + 1, std::uint8_t(0));
+
+        for (std::size_t i = 1; i <= rows; ++i)
+        {
+            p[0] = static_cast<std::uint8_t>(i);
+            std::size_t j0 = 0;
+            std::fill_n(minv.begin(), cols + 1, INF);
+            std::fill_n(used.begin(), cols + 1, false);
+
+            do
+            {
+                used[j0] = true;
+                std::size_t i0 = p[j0];
+                const T* w = &weight[(i0 - 1) * N];
+                T delta = INF;
+                std::size_t j1 = 0;
+
+                for (std::size_t j = 1; j <= cols; ++j)
+                {
+                    if (!used[j])
+                    {
+                        T cur = -w[j - 1] - u[i0] - v[j];
+                        if (cur < minv[j])
+                        {
+                            minv[j] = cur;
+                            way[j] = static_cast<std::uint8_t>(j0);
+                        }
+                        if (minv[j] < delta)
+                        {
+                            delta = minv[j];
+                            j1 = j;
+                        }
+                    }
+                }
+
+                for (std::size_t j = 0; j <= cols; ++j)
+                {
+                    if (used[j])
+                    {
+                        u[p[j]] += delta;
+                        v[j] -= delta;
+                    }
+                    else
+                    {
+                        minv[j] -= delta;
+                    }
+                }
+                j0 = j1;
+            } while (p[j0] != 0);
+
+            do
+            {
+                std::size_t j1 = way[j0];
+                p[j0] = p[j1];
+                j0 = j1;
+            } while (j0 != 0);
+        }
+
+        T total = T(0);
+        for (std::size_t j = 1; j <= cols; ++j)
+        {
+            if (p[j] > 0)
+            {
+                best_pick[p[j] - 1] = static_cast<std::uint8_t>(j - 1);
+                total += weight[(p[j] - 1) * N + j - 1];
+            }
+        }
+        return total;
+    }
+
+private:
+    bool transposed = false;
+    std::size_t rows = 0;
+    std::size_t cols = 0;
+
+    std::array<T, N * N> weight{};
+    std::array<std::uint8_t, N> best_pick{};
+
+    // Перебор
+    T best_value = T(0);
+    std::array<T, N + 1> bound{};
+    std::array<std::uint8_t, N> pick{};
+
+    // Венгерский алгоритм
+    std::array<T, N + 1> u{};
+    std::array<T, N + 1> v{};
+    std::array<T, N + 1> minv{};
+    std::array<std::uint8_t, N + 1> p{};
+    std::array<std::uint8_t, N + 1> way{};
+    std::array<bool, N + 1> used{};
+};
+
+
+// Диспетчер точного решателя: маленькие экземпляры решаются SmallAssignment
+// подходящего размера, остальные - венгерским алгоритмом
+template<typename T>
+T SolveAssignmentExact(int n, int m, std::vector<std::vector<T>>& alpha, std::vector<int>& assignment)
+{
+    const int size = std::max(n, m);
+
+    if (size <= 5)
+    {
+        SmallAssignment<5, T> solver;
+        return solver.Start(n, m, alpha, assignment);
+    }
+    if (size <= 8)
+    {
+        SmallAssignment<8, T> solver;
+        return solver.Start(n, m, alpha, assignment);
+    }
+    if (size <= 12)
+    {
+        SmallAssignment<12, T> solver;
+        return solver.Start(n, m, alpha, assignment);
+    }
+    if (size <= 16)
+    {
+        SmallAssignment<16, T> solver;
+        return solver.Start(n, m, alpha, assignment);
+    }
+
+    // Венгерский алгоритм требует n <= m (иначе не находит свободного столбца и
+    // зацикливается) - при n > m решается транспонированная задача
+    if (n > m)
+    {
+        std::vector<std::vector<T>> transposed(m, std::vector<T>(n));
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < m; ++j)
+                transposed[j][i] = alpha[i][j];
+
+        std::vector<int> N_max(n, 1);
+        std::vector<int> task_robot;
+        HungarianAlgo<T> hungarian_algo(m, n, transposed, N_max);
+        T value = hungarian_algo.Start(task_robot);
+
+        assignment.assign(n, -1);
+        for (int j = 0; j < m; ++j)
+            if (task_robot[j] != -1)
+                assignment[task_robot[j]] = j;
+        return value;
+    }
+
+    std::vector<int> N_max(m, 1);
+    HungarianAlgo<T> hungarian_algo(n, m, alpha, N_max);
+    return hungarian_algo.Start(assignment);
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef SOLVER_CONFIG
+#define SOLVER_CONFIG
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+
+// Решатели, которые запрос может выбрать полем "solvers" параметров. Значения - биты
+// SolverConfig::solvers
+enum class SolverKind : unsigned
+{
+    Auction = 1u << 0,
+    Greedy = 1u << 1,
+    Hungarian = 1u << 2
+};
+
+constexpr SolverKind all_solver_kinds[] = {SolverKind::Auction, SolverKind::Greedy, SolverKind::Hungarian};
+
+// "auction", "greedy", "hungarian"; иначе false
+inline bool ParseSolverKind(std::string_view name, SolverKind& kind) noexcept
+{
+    if (name == "auction") kind = SolverKind::Auction;
+    else if (name == "greedy") kind = SolverKind::Greedy;
+    else if (name == "hungarian") kind = SolverKind::Hungarian;
+    else return false;
+    return true;
+}
+
+inline const char* SolverKindName(SolverKind kind) noexcept
+{
+    switch (kind)
+    {
+    case SolverKind::Auction: return "auction";
+    case SolverKind::Greedy: return "greedy";
+    default: return "hungarian";
+    }
+}
+
+// Параметры решения одного запроса. Объект неизменяем после разбора запроса и
+// передаётся по const-ссылке через весь конвейер, поэтому запросы с разными
+// радиусами и масштабами полезности решаются параллельно без общих переменных
+struct SolverConfig
+{
+    double min_utility = 1.0;
+    double max_utility = 30.0;
+    double visibility_radius = 100.0;
+    double distance_offset = 0.1;
+    double epsilon = 1e-3;
+    // Точный решатель требует плотной матрицы n * m - выше этого порога он не запускается
+    std::size_t max_exact_cells = 25'000'000;
+    // Память под кэш строк оракула полезностей для аукциона
+    std::size_t oracle_cache_bytes = 64u << 20;
+    // Выбранные решатели (биты SolverKind); по умолчанию - все
+    unsigned solvers = static_cast<unsigned>(SolverKind::Auction) |
+                       static_cast<unsigned>(SolverKind::Greedy) |
+                       static_cast<unsigned>(SolverKind::Hungarian);
+
+    [[nodiscard]] bool Runs(SolverKind kind) const noexcept
+    {
+        return (solvers & static_cast<unsigned>(kind)) != 0;
+    }
+
+    // Бросает std::invalid_argument, если параметры не дают корректной задачи
+    void Validate() const
+    {
+        if (!std::isfinite(max_utility) || max_utility <= 0.0)
+            throw std::invalid_argument("max_utility must be positive");
+        if (!std::isfinite(min_utility) || min_utility < 0.0 || min_utility > max_utility)
+            throw std::invalid_argument("min_utility must be in [0, max_utility]");
+        if (!std::isfinite(visibility_radius) || visibility_radius < 0.0)
+            throw std::invalid_argument("visibility_radius must be non-negative");
+        if (!std::isfinite(distance_offset) || distance_offset <= 0.0)
+            throw std::invalid_argument("distance_offset must be positive");
+        if (!std::isfinite(epsilon) || epsilon <= 0.0)
+            throw std::invalid_argument("epsilon must be positive");
+        if (solvers == 0)
+            throw std::invalid_argument("solvers must not be empty");
+    }
+};
+
+#endif
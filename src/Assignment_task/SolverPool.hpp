@@ -0,0 +1,259 @@
+#ifndef SOLVER_POOL
+#define SOLVER_POOL
+
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+#include <optional>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+
+#include "Parallel.hpp"
+
+// Пул решателей с двумя полосами: маленькие экземпляры (n * m < large_cells) и
+// большие. У каждой полосы свои потоки и своя ограниченная очередь, поэтому
+// тяжёлые решения не занимают все ядра, а мелкие запросы не ждут за ними.
+// Если в полосе нет места, TrySubmit сразу отказывает - сервер отвечает 503.
+// Задача сама может делить работу между потоками (компоненты, матрица полезностей);
+// сколько потоков ей можно взять, говорит JobThreads: в маленькой полосе - один,
+// в большой - её доля ядер, оставшихся после маленькой
+enum class SolverLane
+{
+    Small = 0,
+    Large = 1
+};
+
+struct SolverPoolOptions
+{
+    std::size_t small_threads = std::max<std::size_t>(1, DefaultThreadCount() / 2);
+    std::size_t large_threads = 1;
+    // Сколько задач может ждать сверх свободных потоков
+    std::size_t small_queue = 64;
+    std::size_t large_queue = 4;
+    // Граница полос по числу ячеек n * m
+    std::size_t large_cells = 1'000'000;
+};
+
+// Полоса заполнена. Бросается там, где отказ TrySubmit нужно передать дальше
+// исключением (например, ожидающим того же результата в ResultCache)
+class SolverQueueFull : public std::runtime_error
+{
+public:
+    SolverQueueFull() : std::runtime_error("solver queue is full") {}
+};
+
+struct SolverLaneStats
+{
+    std::size_t workers = 0;
+    std::size_t job_threads = 0;
+    std::size_t queued = 0;
+    std::size_t running = 0;
+    std::size_t reserved = 0;
+    std::size_t completed = 0;
+    std::size_t rejected = 0;
+};
+
+class SolverPool
+{
+    struct Lane;
+
+public:
+    // Свободные потоки полосы, отданные задаче под её собственные потоки: пока резерв
+    // жив, они не берут задачи из очереди и не считаются свободными при приёме
+    class Reservation
+    {
+    public:
+        Reservation(Lane& lane, std::size_t count) : lane(&lane), count(count) {}
+        Reservation(Reservation&& other) noexcept : lane(other.lane), count(other.count) { other.count = 0; }
+        Reservation(const Reservation&) = delete;
+        Reservation& operator=(const Reservation&) = delete;
+        Reservation& operator=(Reservation&&) = delete;
+
+        ~Reservation()
+        {
+            if (!count)
+                return;
+            {
+                std::lock_guard<std::mutex> lock(lane->mutex);
+                lane->reserved -= count;
+            }
+            lane->ready.notify_all();
+        }
+
+        [[nodiscard]] std::size_t Count() const noexcept { return count; }
+
+    private:
+        Lane* lane;
+        std::size_t count;
+    };
+
+    explicit SolverPool(const SolverPoolOptions& options) : large_cells(options.large_cells)
+    {
+        const std::size_t small_threads = std::max<std::size_t>(1, options.small_threads);
+        const std::size_t large_threads = std::max<std::size_t>(1, options.large_threads);
+        const std::size_t cores = DefaultThreadCount();
+        const std::size_t large_share = cores > small_threads ? (cores - small_threads) / large_threads : 0;
+
+        Start(lanes[0], small_threads, options.small_queue, 1);
+        Start(lanes[1], large_threads, options.large_queue, std::max<std::size_t>(1, large_share));
+    }
+
+    // Очереди дорабатываются до конца: все выданные future получают результат
+    ~SolverPool()
+    {
+        for (Lane& lane : lanes)
+        {
+            {
+                std::lock_guard<std::mutex> lock(lane.mutex);
+                lane.stopping = true;
+            }
+            lane.ready.notify_all();
+        }
+
+        for (Lane& lane : lanes)
+            for (std::thread& worker : lane.workers)
+                worker.join();
+    }
+
+    SolverPool(const SolverPool&) = delete;
+    SolverPool& operator=(const SolverPool&) = delete;
+
+    [[nodiscard]] SolverLane LaneFor(std::size_t cells) const noexcept
+    {
+        return cells >= large_cells ? SolverLane::Large : SolverLane::Small;
+    }
+
+    // job(queue_wait_ms) выполняется в потоке полосы; исключение из job передаётся
+    // через future. Пустой optional - полоса заполнена
+    template<typename F>
+    std::optional<std::future<std::invoke_result_t<F&, double>>> TrySubmit(std::size_t cells, F&& job)
+    {
+        using Result = std::invoke_result_t<F&, double>;
+
+        auto task = std::make_shared<std::packaged_task<Result(double)>>(std::forward<F>(job));
+        std::future<Result> result = task->get_future();
+
+        Lane& lane = lanes[static_cast<int>(LaneFor(cells))];
+        {
+            std::lock_guard<std::mutex> lock(lane.mutex);
+
+            const std::size_t idle = lane.workers.size() - lane.running - lane.reserved;
+            if (lane.stopping || lane.queue.size() >= idle + lane.capacity)
+            {
+                lane.rejected++;
+                return std::nullopt;
+            }
+
+            lane.queue.push_back({[task](double wait_ms) { (*task)(wait_ms); }, Clock::now()});
+        }
+        lane.ready.notify_one();
+
+        return result;
+    }
+
+    // Берёт до wanted свободных потоков полосы, которые не нужны очереди. Вызывается
+    // из задачи; не ждёт - если свободных нет, резерв пустой
+    [[nodiscard]] Reservation Reserve(SolverLane which, std::size_t wanted)
+    {
+        Lane& lane = lanes[static_cast<int>(which)];
+        std::lock_guard<std::mutex> lock(lane.mutex);
+
+        const std::size_t idle = lane.workers.size() - lane.running - lane.reserved;
+        const std::size_t count = idle > lane.queue.size() ? std::min(wanted, idle - lane.queue.size()) : 0;
+        lane.reserved += count;
+        return Reservation(lane, count);
+    }
+
+    // Сколько потоков может занять одна задача полосы, вместе с потоком самой полосы
+    [[nodiscard]] std::size_t JobThreads(SolverLane which) const noexcept
+    {
+        return lanes[static_cast<int>(which)].job_threads;
+    }
+
+    [[nodiscard]] SolverLaneStats Stats(SolverLane which) const
+    {
+        const Lane& lane = lanes[static_cast<int>(which)];
+        std::lock_guard<std::mutex> lock(lane.mutex);
+
+        SolverLaneStats stats;
+        stats.workers = lane.workers.size();
+        stats.job_threads = lane.job_threads;
+        stats.queued = lane.queue.size();
+        stats.running = lane.running;
+        stats.reserved = lane.reserved;
+        stats.completed = lane.completed;
+        stats.rejected = lane.rejected;
+        return stats;
+    }
+
+    [[nodiscard]] std::size_t LargeCells() const noexcept { return large_cells; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job
+    {
+        std::function<void(double)> run;
+        Clock::time_point enqueued;
+    };
+
+    struct Lane
+    {
+        mutable std::mutex mutex;
+        std::condition_variable ready;
+        std::deque<Job> queue;
+        std::vector<std::thread> workers;
+        std::size_t capacity = 0;
+        std::size_t job_threads = 1;
+        std::size_t running = 0;
+        std::size_t reserved = 0;
+        std::size_t completed = 0;
+        std::size_t rejected = 0;
+        bool stopping = false;
+    };
+
+    void Start(Lane& lane, std::size_t threads, std::size_t capacity, std::size_t job_threads)
+    {
+        lane.capacity = capacity;
+        lane.job_threads = job_threads;
+        for (std::size_t t = 0; t < threads; ++t)
+            lane.workers.emplace_back([this, &lane] { Worker(lane); });
+    }
+
+    void Worker(Lane& lane)
+    {
+        std::unique_lock<std::mutex> lock(lane.mutex);
+        while (true)
+        {
+            lane.ready.wait(lock, [&] {
+                return lane.stopping || (!lane.queue.empty() && lane.running + lane.reserved < lane.workers.size());
+            });
+            if (lane.queue.empty())
+                return;
+
+            Job job = std::move(lane.queue.front());
+            lane.queue.pop_front();
+            lane.running++;
+            lock.unlock();
+
+            const double wait_ms = std::chrono::duration<double, std::milli>(Clock::now() - job.enqueued).count();
+            job.run(wait_ms);
+
+            lock.lock();
+            lane.running--;
+            lane.completed++;
+        }
+    }
+
+private:
+    std::size_t large_cells;
+    Lane lanes[2];
+};
+
+#endif
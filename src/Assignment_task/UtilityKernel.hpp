@@ -0,0 +1,129 @@
+#ifndef UTILITY_KERNEL
+#define UTILITY_KERNEL
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#include "Coords.hpp"
+#include "Parallel.hpp"
+
+// Ядро расчёта полезностей alpha_ij = max_utility / (|r_i - t_j| + offset).
+// Строка пишется за один проход: AVX по 4, SSE2 по 2 значения, иначе скалярно.
+// Для больших строк запись идёт в обход кэша (stream), так как матрица alpha
+// для 10k x 10k всё равно не помещается в кэш и читается уже после генерации.
+// sqrt и деление в SIMD округляются так же, как скалярные, поэтому результат
+// совпадает с calculate_distance побитно.
+namespace UtilityKernel
+{
+// Начиная с этой длины строки запись идёт в обход кэша
+constexpr std::size_t stream_threshold = 4096;
+
+inline double Utility(double rx, double ry, double tx, double ty, double max_utility, double offset) noexcept
+{
+    double dx = tx - rx;
+    double dy = ty - ry;
+    return max_utility / (std::sqrt(dx * dx + dy * dy) + offset);
+}
+
+// allow_stream = false - строка будет сразу же прочитана (буфер оракула), её нужно оставить в кэше
+inline void FillRow(double rx, double ry, const double* tx, const double* ty, std::size_t m,
+                    double max_utility, double offset, double* out, bool allow_stream = true) noexcept
+{
+    std::size_t j = 0;
+
+#if defined(__AVX__)
+    const bool stream = allow_stream && m >= stream_threshold;
+    if (stream)
+    {
+        // Потоковая запись требует выравнивания по 32 байта
+        for (; j < m && (reinterpret_cast<std::uintptr_t>(out + j) & 31); ++j)
+            out[j] = Utility(rx, ry, tx[j], ty[j], max_utility, offset);
+    }
+
+    const __m256d vrx = _mm256_set1_pd(rx);
+    const __m256d vry = _mm256_set1_pd(ry);
+    const __m256d vmax = _mm256_set1_pd(max_utility);
+    const __m256d voff = _mm256_set1_pd(offset);
+
+    for (; j + 4 <= m; j += 4)
+    {
+        __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(tx + j), vrx);
+        __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ty + j), vry);
+        __m256d d = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+        __m256d u = _mm256_div_pd(vmax, _mm256_add_pd(d, voff));
+
+        if (stream)
+            _mm256_stream_pd(out + j, u);
+        else
+            _mm256_storeu_pd(out + j, u);
+    }
+
+    if (stream)
+        _mm_sfence();
+#elif defined(__SSE2__) || defined(_M_X64)
+    const bool stream = allow_stream && m >= stream_threshold;
+    if (stream && (reinterpret_cast<std::uintptr_t>(out) & 15))
+    {
+        out[0] = Utility(rx, ry, tx[0], ty[0], max_utility, offset);
+        j = 1;
+    }
+
+    const __m128d vrx = _mm_set1_pd(rx);
+    const __m128d vry = _mm_set1_pd(ry);
+    const __m128d vmax = _mm_set1_pd(max_utility);
+    const __m128d voff = _mm_set1_pd(offset);
+
+    for (; j + 2 <= m; j += 2)
+    {
+        __m128d dx = _mm_sub_pd(_mm_loadu_pd(tx + j), vrx);
+        __m128d dy = _mm_sub_pd(_mm_loadu_pd(ty + j), vry);
+        __m128d d = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)));
+        __m128d u = _mm_div_pd(vmax, _mm_add_pd(d, voff));
+
+        if (stream)
+            _mm_stream_pd(out + j, u);
+        else
+            _mm_storeu_pd(out + j, u);
+    }
+
+    if (stream)
+        _mm_sfence();
+#endif
+
+    for (; j < m; ++j)
+        out[j] = Utility(rx, ry, tx[j], ty[j], max_utility, offset);
+}
+
+// Заполняет матрицу alpha (n x m), строки распределяются по потокам блоками.
+// Маленькие матрицы считаются в вызывающем потоке
+inline void FillMatrix(const Coords& robots, const Coords& tasks, double max_utility, double offset,
+                       std::vector<std::vector<double>>& alpha, std::size_t threads = 0)
+{
+    const std::size_t n = robots.size();
+    const std::size_t m = tasks.size();
+
+    // Строки выделяются и заполняются в том же потоке, отдельного прохода
+    // с заполнением -inf нет: ядро перезаписывает каждую ячейку
+    alpha.resize(n);
+
+    const std::size_t min_rows = std::max<std::size_t>(1, 65536 / std::max<std::size_t>(m, 1));
+
+    ParallelFor(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            alpha[i].resize(m);
+            FillRow(robots.x[i], robots.y[i], tasks.x.data(), tasks.y.data(), m, max_utility, offset, alpha[i].data());
+        }
+    }, min_rows, threads);
+}
+}
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef UTILITY_ORACLE
+#define UTILITY_ORACLE
+
+#include <vector>
+#include <list>
+#include <iterator>
+#include <algorithm>
+#include <unordered_map>
+#include <stdexcept>
+
+#include "Coords.hpp"
+#include "UtilityKernel.hpp"
+
+// Источники полезностей для решателей. Решатель обращается к ним только через
+//     const T* Row(i, scratch) - строка i (m значений), scratch - буфер вызывающего;
+//     T At(i, j)               - одно значение.
+// Указатель из Row действителен до следующего вызова Row того же источника.
+
+// Обёртка над готовой плотной матрицей
+template<typename T>
+class DenseUtility
+{
+public:
+    explicit DenseUtility(const std::vector<std::vector<T>>& alpha) noexcept : alpha(alpha) {}
+
+    [[nodiscard]] const T* Row(std::size_t i, std::vector<T>&) const noexcept { return alpha[i].data(); }
+    [[nodiscard]] T At(std::size_t i, std::size_t j) const noexcept { return alpha[i][j]; }
+
+private:
+    const std::vector<std::vector<T>>& alpha;
+};
+
+
+// Полезности max_utility / (|r_i - t_j| + offset), вычисляемые по координатам
+// по требованию: память O(n + m) вместо O(n * m). Строка считается ядром
+// UtilityKernel::FillRow в буфер вызывающего.
+//
+// SetCache включает LRU-кэш из max_tiles блоков по rows_per_tile строк - полезно,
+// когда решатель многократно проходит по одним и тем же строкам (аукцион внутри
+// небольшой компоненты). С кэшем Row не потокобезопасен.
+class UtilityOracle
+{
+public:
+    UtilityOracle(const Coords& robots, const Coords& tasks, double max_utility, double offset) noexcept
+        : robots(robots), tasks(tasks), max_utility(max_utility), offset(offset)
+    {
+    }
+
+    void SetCache(std::size_t rows_per_tile, std::size_t max_tiles)
+    {
+        if (max_tiles > 0 && rows_per_tile == 0)
+        {
+            throw std::invalid_argument("UtilityOracle tile must contain at least one row");
+        }
+
+        this->rows_per_tile = rows_per_tile;
+        this->max_tiles = max_tiles;
+        tiles.clear();
+        tile_index.clear();
+    }
+
+    [[nodiscard]] std::size_t Rows() const noexcept { return robots.size(); }
+    [[nodiscard]] std::size_t Cols() const noexcept { return tasks.size(); }
+
+    [[nodiscard]] double At(std::size_t i, std::size_t j) const noexcept
+    {
+        return UtilityKernel::Utility(robots.x[i], robots.y[i], tasks.x[j], tasks.y[j], max_utility, offset);
+    }
+
+    [[nodiscard]] const double* Row(std::size_t i, std::vector<double>& scratch) const
+    {
+        if (max_tiles == 0)
+        {
+            scratch.resize(tasks.size());
+            FillRow(i, scratch.data());
+            return scratch.data();
+        }
+
+        const std::size_t tile = i / rows_per_tile;
+        auto it = tile_index.find(tile);
+        if (it != tile_index.end())
+        {
+            hits++;
+            tiles.splice(tiles.begin(), tiles, it->second);
+        }
+        else
+        {
+            misses++;
+            if (tiles.size() >= max_tiles)
+            {
+                // Вытесняем давно не использованный блок, переиспользуя его память
+                tiles.splice(tiles.begin(), tiles, std::prev(tiles.end()));
+                tile_index.erase(tiles.front().first);
+            }
+            else
+            {
+                tiles.emplace_front();
+            }
+
+            Tile& block = tiles.front();
+            block.first = tile;
+
+            const std::size_t first_row = tile * rows_per_tile;
+            const std::size_t count = std::min(rows_per_tile, robots.size() - first_row);
+            block.second.resize(count * tasks.size());
+            for (std::size_t r = 0; r < count; ++r)
+                FillRow(first_row + r, block.second.data() + r * tasks.size());
+
+            tile_index[tile] = tiles.begin();
+        }
+
+        return tiles.front().second.data() + (i % rows_per_tile) * tasks.size();
+    }
+
+    // Плотная матрица - только для точных решателей, которым она действительно нужна
+    void Materialize(std::vector<std::vector<double>>& alpha, std::size_t threads = 0) const
+    {
+        UtilityKernel::FillMatrix(robots, tasks, max_utility, offset, alpha, threads);
+    }
+
+    [[nodiscard]] std::size_t CacheHits() const noexcept { return hits; }
+    [[nodiscard]] std::size_t CacheMisses() const noexcept { return misses; }
+
+private:
+    void FillRow(std::size_t i, double* out) const noexcept
+    {
+        UtilityKernel::FillRow(robots.x[i], robots.y[i], tasks.x.data(), tasks.y.data(), tasks.size(),
+                               max_utility, offset, out, false);
+    }
+
+private:
+    using Tile = std::pair<std::size_t, std::vector<double>>; // номер блока, строки блока
+
+    const Coords& robots;
+    const Coords& tasks;
+    double max_utility;
+    double offset;
+
+    std::size_t rows_per_tile = 0;
+    std::size_t max_tiles = 0;
+
+    mutable std::list<Tile> tiles;
+    mutable std::unordered_map<std::size_t, std::list<Tile>::iterator> tile_index;
+    mutable std::size_t hits = 0;
+    mutable std::size_t misses = 0;
+};
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef VISIBILITY_GRAPH
+#define VISIBILITY_GRAPH
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+
+#include "Coords.hpp"
+
+// Равномерная сетка с ячейкой не меньше радиуса видимости: все соседи точки лежат
+// в её ячейке или в одной из 8 соседних. Ячейки хранятся разреженно - отсортированный
+// список непустых ячеек и диапазоны точек в них, поэтому память O(n) при любом
+// разбросе координат.
+class SpatialGrid
+{
+public:
+    struct Cell
+    {
+        std::int64_t cx, cy;
+
+        bool operator<(const Cell& other) const noexcept
+        {
+            return cx < other.cx || (cx == other.cx && cy < other.cy);
+        }
+        bool operator==(const Cell& other) const noexcept
+        {
+            return cx == other.cx && cy == other.cy;
+        }
+    };
+
+    void Build(const Coords& points, double cell_size)
+    {
+        const std::size_t n = points.size();
+        size = cell_size > 0.0 ? cell_size : 1.0;
+
+        min_x = n ? *std::min_element(points.x.begin(), points.x.end()) : 0.0;
+        min_y = n ? *std::min_element(points.y.begin(), points.y.end()) : 0.0;
+
+        std::vector<Cell> point_cell(n);
+        for (std::size_t i = 0; i < n; ++i)
+            point_cell[i] = CellOf(points.x[i], points.y[i]);
+
+        order.resize(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            return point_cell[a] < point_cell[b];
+        });
+
+        cells.clear();
+        cell_start.clear();
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            const Cell& cell = point_cell[order[k]];
+            if (cells.empty() || !(cells.back() == cell))
+            {
+                cells.push_back(cell);
+                cell_start.push_back(k);
+            }
+        }
+        cell_start.push_back(n);
+    }
+
+    [[nodiscard]] Cell CellOf(double x, double y) const noexcept
+    {
+        return {static_cast<std::int64_t>(std::floor((x - min_x) / size)),
+                static_cast<std::int64_t>(std::floor((y - min_y) / size))};
+    }
+
+    [[nodiscard]] std::size_t NumCells() const noexcept { return cells.size(); }
+    [[nodiscard]] const Cell& CellAt(std::size_t c) const noexcept { return cells[c]; }
+
+    // Точки ячейки c: order[cell_start[c]] .. order[cell_start[c + 1] - 1]
+    [[nodiscard]] const int* Begin(std::size_t c) const noexcept { return order.data() + cell_start[c]; }
+    [[nodiscard]] const int* End(std::size_t c) const noexcept { return order.data() + cell_start[c + 1]; }
+
+    // Индекс непустой ячейки или NumCells(), если такой нет
+    [[nodiscard]] std::size_t Find(const Cell& cell) const noexcept
+    {
+        auto it = std::lower_bound(cells.begin(), cells.end(), cell);
+        return (it != cells.end() && *it == cell) ? static_cast<std::size_t>(it - cells.begin()) : cells.size();
+    }
+
+    // Вызывает f(a, b) для каждой соседней пары ячеек ровно один раз: ячейка с собой
+    // и 4 соседа "вперёд" (остальные 4 посещаются с другой стороны)
+    template<typename F>
+    void ForEachNeighbourCell(std::size_t c, F&& f) const
+    {
+        static const std::int64_t forward[4][2] = {{0, 1}, {1, -1}, {1, 0}, {1, 1}};
+
+        f(c, c);
+        for (const auto& d : forward)
+        {
+            std::size_t other = Find({cells[c].cx + d[0], cells[c].cy + d[1]});
+            if (other != cells.size())
+                f(c, other);
+        }
+    }
+
+private:
+    double size = 1.0;
+    double min_x = 0.0;
+    double min_y = 0.0;
+
+    std::vector<int> order;
+    std::vector<Cell> cells;
+    std::vector<std::size_t> cell_start;
+};
+
+
+// Граф видимости роботов в формате CSR: соседи робота i -
+// neighbors[offsets[i]] .. neighbors[offsets[i + 1] - 1], по возрастанию номера
+struct VisibilityGraph
+{
+    std::vector<std::size_t> offsets;
+    std::vector<int> neighbors;
+
+    [[nodiscard]] std::size_t size() const noexcept { return offsets.empty() ? 0 : offsets.size() - 1; }
+    [[nodiscard]] const int* begin(std::size_t i) const noexcept { return neighbors.data() + offsets[i]; }
+    [[nodiscard]] const int* end(std::size_t i) const noexcept { return neighbors.data() + offsets[i + 1]; }
+};
+
+
+// Построение графа видимости: пары проверяются только внутри соседних ячеек сетки,
+// O(n + E) при равномерном распределении вместо O(n^2)
+inline void BuildVisibilityGraph(const Coords& robots, double radius, VisibilityGraph& graph)
+{
+    const std::size_t n = robots.size();
+    const double radius_sq = radius * radius;
+
+    // Ячейка чуть больше радиуса, чтобы пары ровно на границе не терялись из-за округления
+    SpatialGrid grid;
+    grid.Build(robots, radius * (1.0 + 1e-9));
+
+    // Рёбра собираются парами (i, j), затем раскладываются по строкам подсчётом
+    std::vector<std::pair<int, int>> edges;
+    auto visit = [&](std::size_t a, std::size_t b) {
+        for (const int* p = grid.Begin(a); p != grid.End(a); ++p)
+        {
+            const int* q = (a == b) ? p + 1 : grid.Begin(b);
+            for (; q != grid.End(b); ++q)
+            {
+                double dx = robots.x[*q] - robots.x[*p];
+                double dy = robots.y[*q] - robots.y[*p];
+                if (dx * dx + dy * dy <= radius_sq)
+                    edges.push_back({*p, *q});
+            }
+        }
+    };
+
+    if (radius >= 0.0)
+    {
+        for (std::size_t c = 0; c < grid.NumCells(); ++c)
+            grid.ForEachNeighbourCell(c, visit);
+    }
+
+    graph.offsets.assign(n + 1, 0);
+    for (const auto& [i, j] : edges)
+    {
+        graph.offsets[i + 1]++;
+        graph.offsets[j + 1]++;
+    }
+    for (std::size_t i = 0; i < n; ++i)
+        graph.offsets[i + 1] += graph.offsets[i];
+
+    graph.neighbors.resize(graph.offsets[n]);
+    std::vector<std::size_t> fill(graph.offsets.begin(), graph.offsets.end() - 1);
+    for (const auto& [i, j] : edges)
+    {
+        graph.neighbors[fill[i]++] = j;
+        graph.neighbors[fill[j]++] = i;
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+        std::sort(graph.neighbors.begin() + graph.offsets[i], graph.neighbors.begin() + graph.offsets[i + 1]);
+}
+
+#endif
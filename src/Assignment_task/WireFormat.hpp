@@ -0,0 +1,184 @@
+#ifndef WIRE_FORMAT
+#define WIRE_FORMAT
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+#include "Coords.hpp"
+
+// Бинарное кодирование запросов и ответов /run_auction (application/x-assignment).
+// Все числа little-endian, секции выровнены по 8 байт.
+//
+// Запрос:
+//     RequestHeader             - "ASGQ", версия, n, m, длина config
+//     config                    - JSON-объект параметров (как поле "config"), может быть пустым
+//     double x[n], y[n]         - роботы
+//     double x[m], y[m]         - задачи
+//
+// Ответ:
+//     ResponseHeader            - "ASGR", версия, n, число массивов, длина meta
+//     meta                      - JSON со скалярными полями ответа (полезности, времена, config)
+//     int32 assignment[n] * k   - назначения запущенных решателей (аукцион, жадный,
+//                                 венгерский) в порядке списка meta["assignments"]
+//
+// Массивы копируются целиком, без поэлементного разбора: координаты читаются
+// прямо в Coords, назначения пишутся одним memcpy
+namespace WireFormat
+{
+inline constexpr const char* content_type = "application/x-assignment";
+inline constexpr std::uint16_t version = 1;
+
+struct RequestHeader
+{
+    char magic[4];           // "ASGQ"
+    std::uint16_t version;
+    std::uint16_t flags;     // зарезервировано, 0
+    std::uint32_t n;
+    std::uint32_t m;
+    std::uint32_t config_size;
+    std::uint32_t reserved;
+};
+
+struct ResponseHeader
+{
+    char magic[4];           // "ASGR"
+    std::uint16_t version;
+    std::uint16_t arrays;
+    std::uint32_t n;
+    std::uint32_t meta_size;
+};
+
+static_assert(sizeof(RequestHeader) == 24, "RequestHeader layout is part of the wire format");
+static_assert(sizeof(ResponseHeader) == 16, "ResponseHeader layout is part of the wire format");
+
+inline std::size_t Align8(std::size_t value) noexcept { return (value + 7) & ~std::size_t(7); }
+
+inline bool IsLittleEndian() noexcept
+{
+    const std::uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+inline void CheckHost()
+{
+    if (!IsLittleEndian())
+    {
+        throw std::runtime_error("binary encoding requires a little-endian host");
+    }
+}
+
+// Разбор запроса; некорректное тело - std::invalid_argument
+inline void DecodeRequest(std::string_view body, Coords& robots, Coords& tasks, std::string& config)
+{
+    CheckHost();
+
+    if (body.size() < sizeof(RequestHeader))
+        throw std::invalid_argument("binary request is shorter than its header");
+
+    RequestHeader header;
+    std::memcpy(&header, body.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, "ASGQ", 4) != 0)
+        throw std::invalid_argument("binary request has bad magic");
+    if (header.version != version)
+        throw std::invalid_argument("unsupported binary request version");
+
+    const std::size_t coords_offset = Align8(sizeof(header) + header.config_size);
+    const std::size_t expected = coords_offset + 2 * (std::size_t(header.n) + header.m) * sizeof(double);
+    if (header.config_size > body.size() || body.size() != expected)
+        throw std::invalid_argument("binary request size does not match n and m");
+
+    config.assign(body.data() + sizeof(header), header.config_size);
+
+    robots.resize(header.n);
+    tasks.resize(header.m);
+
+    // NaN и бесконечности в JSON не записать; здесь их тоже не пропускаем в решатели
+    const char* data = body.data() + coords_offset;
+    auto take = [&](std::vector<double>& out) {
+        std::memcpy(out.data(), data, out.size() * sizeof(double));
+        data += out.size() * sizeof(double);
+        for (double value : out)
+        {
+            if (!std::isfinite(value))
+                throw std::invalid_argument("binary request coordinates must be finite");
+        }
+    };
+    take(robots.x);
+    take(robots.y);
+    take(tasks.x);
+    take(tasks.y);
+}
+
+inline std::string EncodeRequest(const Coords& robots, const Coords& tasks, std::string_view config = {})
+{
+    CheckHost();
+
+    RequestHeader header{};
+    std::memcpy(header.magic, "ASGQ", 4);
+    header.version = version;
+    header.n = static_cast<std::uint32_t>(robots.size());
+    header.m = static_cast<std::uint32_t>(tasks.size());
+    header.config_size = static_cast<std::uint32_t>(config.size());
+
+    const std::size_t coords_offset = Align8(sizeof(header) + config.size());
+    std::string body(coords_offset + 2 * (robots.size() + tasks.size()) * sizeof(double), '\0');
+
+    std::memcpy(body.data(), &header, sizeof(header));
+    std::memcpy(body.data() + sizeof(header), config.data(), config.size());
+
+    char* data = body.data() + coords_offset;
+    auto put = [&](const std::vector<double>& values) {
+        std::memcpy(data, values.data(), values.size() * sizeof(double));
+        data += values.size() * sizeof(double);
+    };
+    put(robots.x);
+    put(robots.y);
+    put(tasks.x);
+    put(tasks.y);
+
+    return body;
+}
+
+// assignments - массивы длины n в порядке секции ответа
+inline std::string EncodeResponse(std::size_t n, std::string_view meta,
+                                  const std::vector<const std::vector<int>*>& assignments)
+{
+    CheckHost();
+
+    ResponseHeader header{};
+    std::memcpy(header.magic, "ASGR", 4);
+    header.version = version;
+    header.arrays = static_cast<std::uint16_t>(assignments.size());
+    header.n = static_cast<std::uint32_t>(n);
+    header.meta_size = static_cast<std::uint32_t>(meta.size());
+
+    const std::size_t arrays_offset = Align8(sizeof(header) + meta.size());
+    std::string body(arrays_offset + assignments.size() * n * sizeof(std::int32_t), '\0');
+
+    std::memcpy(body.data(), &header, sizeof(header));
+    std::memcpy(body.data() + sizeof(header), meta.data(), meta.size());
+
+    char* data = body.data() + arrays_offset;
+    for (const std::vector<int>* assignment : assignments)
+    {
+        if (assignment->size() != n)
+            throw std::logic_error("EncodeResponse: assignment length must equal n");
+
+        static_assert(sizeof(int) == sizeof(std::int32_t), "assignments are sent as int32");
+        std::memcpy(data, assignment->data(), n * sizeof(std::int32_t));
+        data += n * sizeof(std::int32_t);
+    }
+
+    return body;
+}
+}
+
+#endif
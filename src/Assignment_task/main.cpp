@@ -1,6 +1,8 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <chrono>
+#include <cstdio>
 #ifdef _WIN32
 #include <winsock2.h>
 #include <windows.h>
@@ -15,6 +17,20 @@
 
 #include "AuctionAlgo.hpp"
 #include "HungarianAlgo.hpp"
+#include "SmallAssignment.hpp"
+#include "Coords.hpp"
+#include "UtilityKernel.hpp"
+#include "UtilityOracle.hpp"
+#include "GreedyAlgo.hpp"
+#include "ComponentLabeler.hpp"
+#include "SolverPool.hpp"
+#include "SolverConfig.hpp"
+#include "Logger.hpp"
+#include "WireFormat.hpp"
+#include "RequestParser.hpp"
+#include "ResultCache.hpp"
+#include "BatchRunner.hpp"
+#include "Session.hpp"
 #include "httplib.h"
 #include "json.hpp"
 
@@ -27,44 +43,643 @@ void open_browser(const std::string& url) {
     std::string command = "xdg-open " + url;
     int result = system(command.c_str());
     if (result != 0) {
-        std::cerr << "Warning: Failed to open browser with xdg-open\n";
+        Log().Write(LogLevel::Warning, "event=open_browser_failed");
     }
 #endif
 }
 
 void generate_instance(
-    int n, int m,
-    const std::vector<Point>& robot_coords,
-    const std::vector<Point>& task_coords,
-    std::vector<std::vector<double>>& alpha_auction,
-    std::vector<std::vector<int>>& visibility_robots
+    const Coords& robot_coords,
+    const SolverConfig& config,
+    Components& robot_components,
+    std::size_t threads
     )
 {
-    alpha_auction.assign(n, std::vector<double>(m, -std::numeric_limits<double>::infinity()));
-    visibility_robots.assign(n, std::vector<int>(n, 0));
+    // Компоненты видимости строятся сразу по парам соседей в сетке, без списков смежности.
+    // Полезности не материализуются: решатели читают их из UtilityOracle
+    LabelComponents(robot_coords, config.visibility_radius, robot_components, threads);
+}
+
+// Список решателей ["auction", "greedy", "hungarian"] -> биты SolverKind
+unsigned solvers_from_json(const json& names)
+{
+    if (!names.is_array())
+        throw std::invalid_argument("solvers must be a list of solver names");
 
-    for (int i = 0; i < n; ++i)
+    unsigned solvers = 0;
+    for (const json& name : names)
     {
+        SolverKind kind;
+        if (!name.is_string() || !ParseSolverKind(name.get<std::string>(), kind))
+            throw std::invalid_argument("unknown solver: " + name.dump());
+        solvers |= static_cast<unsigned>(kind);
+    }
+    return solvers;
+}
 
-        for (int j = 0; j < n; ++j)
-        {
-            if (i != j && calculate_distance(robot_coords[i], robot_coords[j]) <= PARAMETRS::visibility_radius) {
-                visibility_robots[i][j] = 1;
+json solvers_to_json(unsigned solvers)
+{
+    json names = json::array();
+    for (SolverKind kind : all_solver_kinds)
+    {
+        if (solvers & static_cast<unsigned>(kind))
+            names.push_back(SolverKindName(kind));
+    }
+    return names;
+}
+
+// Параметры запроса: значения из объекта overrides (поле "config" запроса) поверх defaults.
+// Неизвестный ключ - ошибка, чтобы опечатка не превращалась молча в значение по умолчанию
+SolverConfig config_from_json(const json& overrides, const SolverConfig& defaults)
+{
+    SolverConfig config = defaults;
+
+    if (overrides.is_null())
+        return config;
+    if (!overrides.is_object())
+        throw std::invalid_argument("config must be an object");
+
+    for (const auto& [key, value] : overrides.items())
+    {
+        if (key == "min_utility")
+            config.min_utility = value.get<double>();
+        else if (key == "max_utility")
+            config.max_utility = value.get<double>();
+        else if (key == "visibility_radius")
+            config.visibility_radius = value.get<double>();
+        else if (key == "distance_offset")
+            config.distance_offset = value.get<double>();
+        else if (key == "epsilon")
+            config.epsilon = value.get<double>();
+        else if (key == "max_exact_cells")
+            config.max_exact_cells = value.get<std::size_t>();
+        else if (key == "oracle_cache_bytes")
+            config.oracle_cache_bytes = value.get<std::size_t>();
+        else if (key == "solvers")
+            config.solvers = solvers_from_json(value);
+        else
+            throw std::invalid_argument("unknown config key: " + key);
+    }
+
+    config.Validate();
+    return config;
+}
+
+json config_to_json(const SolverConfig& config)
+{
+    return {
+        {"min_utility", config.min_utility},
+        {"max_utility", config.max_utility},
+        {"visibility_radius", config.visibility_radius},
+        {"distance_offset", config.distance_offset},
+        {"epsilon", config.epsilon},
+        {"max_exact_cells", config.max_exact_cells},
+        {"oracle_cache_bytes", config.oracle_cache_bytes},
+        {"solvers", solvers_to_json(config.solvers)}
+    };
+}
+
+// Отладочные дампы: по несколько элементов в строке, чтобы не упираться в длину записи журнала.
+// При уровне выше Debug не делают ничего
+void log_dump(const char* name, const Coords& coords)
+{
+    if (!Log().Enabled(LogLevel::Debug))
+        return;
+
+    const std::size_t per_line = 8;
+    for (std::size_t first = 0; first < coords.size(); first += per_line)
+    {
+        char line[Logger::text_size];
+        int length = std::snprintf(line, sizeof(line), "event=dump name=%s from=%zu", name, first);
+        for (std::size_t i = first; i < std::min(first + per_line, coords.size()) && length < (int)sizeof(line); ++i)
+            length += std::snprintf(line + length, sizeof(line) - length, " %g,%g", coords.x[i], coords.y[i]);
+        Log().Write(LogLevel::Debug, line);
+    }
+}
+
+void log_dump(const char* name, const std::vector<int>& assignment)
+{
+    if (!Log().Enabled(LogLevel::Debug))
+        return;
+
+    const std::size_t per_line = 24;
+    for (std::size_t first = 0; first < assignment.size(); first += per_line)
+    {
+        char line[Logger::text_size];
+        int length = std::snprintf(line, sizeof(line), "event=dump name=%s from=%zu", name, first);
+        for (std::size_t i = first; i < std::min(first + per_line, assignment.size()) && length < (int)sizeof(line); ++i)
+            length += std::snprintf(line + length, sizeof(line) - length, " %d", assignment[i]);
+        Log().Write(LogLevel::Debug, line);
+    }
+}
+
+// Результат решения одного экземпляра. Решатель, не выбранный в config.solvers,
+// оставляет has_* = false и пустое назначение
+struct Solution
+{
+    bool has_auction = false;
+    std::vector<int> auction_assignment;
+    double auction_utility = 0.0;
+    double auction_ms = 0.0;
+
+    bool has_greedy = false;
+    std::vector<int> greedy_assignment;
+    double greedy_utility = 0.0;
+    double greedy_ms = 0.0;
+
+    // Венгерский алгоритм запускается, только если плотная матрица помещается в max_exact_cells
+    bool has_hungarian = false;
+    std::vector<int> hungarian_assignment;
+    double hungarian_utility = 0.0;
+    double hungarian_ms = 0.0;
+
+    double queue_wait_ms = 0.0;
+    double solve_ms = 0.0;
+};
+
+// Наблюдатель за решением экземпляра (потоковый /run_auction_stream)
+struct SolveObserver
+{
+    AuctionProgress<double> auction;
+    // Аукцион завершён; жадный и венгерский ещё не считались
+    std::function<void(const Solution&)> on_auction;
+    // Перед запуском каждого решателя; исключение отменяет оставшиеся
+    std::function<void()> before_solver;
+};
+
+double elapsed_ms(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Решатели по отдельности. Каждый строит только то, что нужно ему самому, и пишет
+// только свои поля Solution, поэтому их можно запускать одновременно в разных потоках.
+// threads - сколько потоков решателю можно занять под компоненты и матрицу (JobThreads полосы)
+void solve_auction(const Coords& robot_coords, const Coords& task_coords, const SolverConfig& config,
+                   std::size_t threads, Solution& solution, const SolveObserver* observer = nullptr)
+{
+    auto start = std::chrono::steady_clock::now();
+    const int n = static_cast<int>(robot_coords.size());
+    const int m = static_cast<int>(task_coords.size());
+
+    AuctionAlgo<double> algo;
+
+    Components robot_components;
+    generate_instance(robot_coords, config, robot_components, threads);
+
+    UtilityOracle oracle(robot_coords, task_coords, config.max_utility, config.distance_offset);
+    if (m > 0)
+        oracle.SetCache(1, std::max<std::size_t>(1, config.oracle_cache_bytes / (sizeof(double) * m)));
+
+    if (observer)
+        algo.SetProgress(&observer->auction);
+    solution.auction_utility = algo.Start(n, m, oracle, robot_components, config.epsilon, solution.auction_assignment);
+    solution.has_auction = true;
+    solution.auction_ms = elapsed_ms(start);
+
+    log_dump("auction_assignment", solution.auction_assignment);
+    if (observer && observer->on_auction)
+        observer->on_auction(solution);
+}
+
+void solve_greedy(const Coords& robot_coords, const Coords& task_coords, const SolverConfig& config, Solution& solution)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    UtilityOracle oracle(robot_coords, task_coords, config.max_utility, config.distance_offset);
+    GreedyAlgo<double> greedy;
+    solution.greedy_utility = greedy.Start(static_cast<int>(robot_coords.size()), static_cast<int>(task_coords.size()),
+                                           oracle, solution.greedy_assignment);
+    solution.has_greedy = true;
+    solution.greedy_ms = elapsed_ms(start);
+}
+
+void solve_hungarian(const Coords& robot_coords, const Coords& task_coords, const SolverConfig& config,
+                     std::size_t threads, Solution& solution)
+{
+    const int n = static_cast<int>(robot_coords.size());
+    const int m = static_cast<int>(task_coords.size());
+
+    // Плотная матрица строится только для точного решателя и только если помещается
+    if (static_cast<std::size_t>(n) * m > config.max_exact_cells)
+        return;
+
+    auto start = std::chrono::steady_clock::now();
+
+    UtilityOracle oracle(robot_coords, task_coords, config.max_utility, config.distance_offset);
+    std::vector<std::vector<double>> alpha;
+    oracle.Materialize(alpha, threads);
+
+    solution.hungarian_utility = SolveAssignmentExact(n, m, alpha, solution.hungarian_assignment);
+    solution.has_hungarian = true;
+    solution.hungarian_ms = elapsed_ms(start);
+
+    log_dump("hungarian_assignment", solution.hungarian_assignment);
+}
+
+// Решение одного экземпляра выбранными решателями по очереди; выполняется в потоке
+// пула решателей. Аукцион идёт первым - его ждёт потоковый ответ
+Solution solve_instance(const Coords& robot_coords, const Coords& task_coords, const SolverConfig& config,
+                        std::size_t threads, const SolveObserver* observer = nullptr)
+{
+    auto checkpoint = [observer] {
+        if (observer && observer->before_solver)
+            observer->before_solver();
+    };
+
+    Solution solution;
+    if (config.Runs(SolverKind::Auction))
+    {
+        checkpoint();
+        solve_auction(robot_coords, task_coords, config, threads, solution, observer);
+    }
+    if (config.Runs(SolverKind::Greedy))
+    {
+        checkpoint();
+        solve_greedy(robot_coords, task_coords, config, solution);
+    }
+    if (config.Runs(SolverKind::Hungarian))
+    {
+        checkpoint();
+        solve_hungarian(robot_coords, task_coords, config, threads, solution);
+    }
+    return solution;
+}
+
+// Выбранные решатели одного запроса - одна задача пула: запрос занимает одно место
+// в полосе, как и прежде, поэтому пределы очередей и число потоков httplib считаются
+// по запросам, а при нехватке места не запускается ничего (SolverQueueFull).
+// Для остальных решателей задача резервирует свободные потоки той же полосы; сколько
+// зарезервировала, столько решателей идёт одновременно (последний - в потоке полосы),
+// остальные по очереди. Без свободных потоков решатели идут по очереди, как в
+// solve_instance, так что полоса не занимает больше ядер, чем у неё потоков.
+// Ошибка любого решателя передаётся вызывающему после того, как закончат все
+Solution solve_concurrently(SolverPool& pool, const Coords& robot_coords, const Coords& task_coords,
+                            const SolverConfig& config)
+{
+    std::vector<SolverKind> kinds;
+    for (SolverKind kind : all_solver_kinds)
+    {
+        if (config.Runs(kind))
+            kinds.push_back(kind);
+    }
+
+    const std::size_t cells = robot_coords.size() * task_coords.size();
+    const SolverLane lane = pool.LaneFor(cells);
+    const std::size_t threads = pool.JobThreads(lane);
+
+    Solution solution;
+    auto job = pool.TrySubmit(cells, [&](double queue_wait_ms) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::exception_ptr> errors(kinds.size());
+        const SolverPool::Reservation extra = pool.Reserve(lane, kinds.size() - 1);
+
+        ParallelFor(0, kinds.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t k = begin; k < end; ++k)
+            {
+                try
+                {
+                    switch (kinds[k])
+                    {
+                    case SolverKind::Auction: solve_auction(robot_coords, task_coords, config, threads, solution); break;
+                    case SolverKind::Greedy: solve_greedy(robot_coords, task_coords, config, solution); break;
+                    case SolverKind::Hungarian: solve_hungarian(robot_coords, task_coords, config, threads, solution); break;
+                    }
+                }
+                catch (...)
+                {
+                    errors[k] = std::current_exception();
+                }
             }
+        }, 1, extra.Count() + 1);
+
+        for (const std::exception_ptr& error : errors)
+        {
+            if (error)
+                std::rethrow_exception(error);
         }
+
+        solution.queue_wait_ms = queue_wait_ms;
+        solution.solve_ms = elapsed_ms(start);
+    });
+
+    if (!job)
+        throw SolverQueueFull();
+    job->get();
+    return solution;
+}
+
+// Ключ кэша результатов: всё, от чего зависит ответ. oracle_cache_bytes влияет
+// только на скорость и в ключ не входит
+CacheKey make_cache_key(const Coords& robot_coords, const Coords& task_coords, const SolverConfig& config)
+{
+    CacheKeyBuilder builder;
+    builder.Add(config.min_utility)
+           .Add(config.max_utility)
+           .Add(config.visibility_radius)
+           .Add(config.distance_offset)
+           .Add(config.epsilon)
+           .Add(static_cast<std::uint64_t>(config.max_exact_cells))
+           .Add(static_cast<std::uint64_t>(config.solvers))
+           .Add(robot_coords.x)
+           .Add(robot_coords.y)
+           .Add(task_coords.x)
+           .Add(task_coords.y);
+    return builder.Build();
+}
+
+std::size_t solution_bytes(const Solution& solution)
+{
+    return sizeof(Solution) + sizeof(int) * (solution.auction_assignment.capacity() +
+                                             solution.greedy_assignment.capacity() +
+                                             solution.hungarian_assignment.capacity());
+}
+
+const char* cache_outcome_name(CacheOutcome outcome)
+{
+    switch (outcome)
+    {
+    case CacheOutcome::Hit: return "hit";
+    case CacheOutcome::Joined: return "joined";
+    default: return "miss";
     }
+}
+
+// Скалярная часть ответа - общая для JSON и бинарного кодирования
+json solution_meta(const Solution& solution, const SolverConfig& config)
+{
+    json meta;
+    meta["auction_utility"] = solution.has_auction ? json(solution.auction_utility) : json(nullptr);
+    meta["greedy_utility"] = solution.has_greedy ? json(solution.greedy_utility) : json(nullptr);
+    meta["hungarian_utility"] = solution.has_hungarian ? json(solution.hungarian_utility) : json(nullptr);
+    meta["visibility_radius"] = config.visibility_radius;
+    meta["config"] = config_to_json(config);
+    meta["queue_wait_ms"] = solution.queue_wait_ms;
+    meta["solve_ms"] = solution.solve_ms;
+
+    // Время каждого запущенного решателя (при параллельном запуске solve_ms - не сумма)
+    json solver_ms = json::object();
+    if (solution.has_auction)
+        solver_ms["auction"] = solution.auction_ms;
+    if (solution.has_greedy)
+        solver_ms["greedy"] = solution.greedy_ms;
+    if (solution.has_hungarian)
+        solver_ms["hungarian"] = solution.hungarian_ms;
+    meta["solver_ms"] = std::move(solver_ms);
+    return meta;
+}
+
+std::string encode_json_response(const Solution& solution, json meta)
+{
+    meta["auction_assignment"] = solution.auction_assignment;
+    meta["greedy_assignment"] = solution.greedy_assignment;
+    meta["hungarian_assignment"] = solution.hungarian_assignment;
+    return meta.dump();
+}
+
+// Массивы - только запущенных решателей; их порядок перечислен в meta["assignments"]
+std::string encode_binary_response(const Solution& solution, json meta, std::size_t n)
+{
+    std::vector<const std::vector<int>*> assignments;
+    json names = json::array();
+    const std::pair<bool, const std::vector<int>*> solved[] = {
+        {solution.has_auction, &solution.auction_assignment},
+        {solution.has_greedy, &solution.greedy_assignment},
+        {solution.has_hungarian, &solution.hungarian_assignment}
+    };
+    for (std::size_t k = 0; k < std::size(solved); ++k)
+    {
+        if (!solved[k].first)
+            continue;
+        assignments.push_back(solved[k].second);
+        names.push_back(SolverKindName(all_solver_kinds[k]));
+    }
+    meta["assignments"] = std::move(names);
+
+    return WireFormat::EncodeResponse(n, meta.dump(), assignments);
+}
+
+// Разбор JSON-запроса потоковым парсером (RequestParser.hpp): координаты пишутся сразу в Coords
+void decode_json_request(const std::string& body, const SolverConfig& defaults,
+                         SolverConfig& config, Coords& robot_coords, Coords& task_coords)
+{
+    json overrides;
+    ParseAuctionRequest(body, robot_coords, task_coords, overrides);
+    config = config_from_json(overrides, defaults);
+}
 
-    for (int i = 0; i < n; ++i)
+// Разбор бинарного запроса (WireFormat.hpp); config передаётся JSON-объектом внутри тела
+void decode_binary_request(const std::string& body, const SolverConfig& defaults,
+                           SolverConfig& config, Coords& robot_coords, Coords& task_coords)
+{
+    std::string overrides;
+    WireFormat::DecodeRequest(body, robot_coords, task_coords, overrides);
+    config = config_from_json(overrides.empty() ? json() : json::parse(overrides), defaults);
+}
+
+// Изменение сессии (PATCH /sessions/{id}):
+//     {"robots": [[i, x, y], ...], "remove_tasks": [j, ...], "add_tasks": [[x, y], ...]}
+// Все поля необязательны; неизвестный ключ - ошибка, как и в config
+SessionUpdate session_update_from_json(const json& body)
+{
+    if (!body.is_object())
+        throw std::invalid_argument("session update must be an object");
+
+    SessionUpdate update;
+    for (const auto& [key, value] : body.items())
     {
-        for (int j = 0; j < m; ++j)
+        if (key == "robots")
         {
-            double distance = calculate_distance(robot_coords[i], task_coords[j]);
-            alpha_auction[i][j] = PARAMETRS::max_utility / (distance + PARAMETRS::DISTANCE_OFFSET);
+            update.moved_robots.reserve(value.size());
+            update.moved_to.resize(value.size());
+            for (std::size_t k = 0; k < value.size(); ++k)
+            {
+                const json& move = value.at(k);
+                if (!move.is_array() || move.size() != 3)
+                    throw std::invalid_argument("a robot move must be [index, x, y]");
+                update.moved_robots.push_back(move[0].get<int>());
+                update.moved_to.Set(k, move[1].get<double>(), move[2].get<double>());
+            }
         }
+        else if (key == "remove_tasks")
+        {
+            update.remove_tasks = value.get<std::vector<int>>();
+        }
+        else if (key == "add_tasks")
+        {
+            update.add_tasks.resize(value.size());
+            for (std::size_t k = 0; k < value.size(); ++k)
+            {
+                const json& point = value.at(k);
+                if (!point.is_array() || point.size() != 2)
+                    throw std::invalid_argument("a point must be [x, y]");
+                update.add_tasks.Set(k, point[0].get<double>(), point[1].get<double>());
+            }
+        }
+        else
+        {
+            throw std::invalid_argument("unknown session update key: " + key);
+        }
+    }
+    return update;
+}
+
+// Решение сессии: аукцион доторговывается от прошлого решения, жадный считается
+// по сохранённой матрице. Аукцион решается всегда - на нём держится тёплый старт;
+// жадный - если выбран в config.solvers. Венгерский алгоритм - только по запросу
+// (exact): тёплого старта у него нет, и для тысяч роботов он дороже всего остального вместе
+Solution solve_session(PlanningSession& session, bool exact, std::size_t threads)
+{
+    Solution solution;
+    auto start = std::chrono::steady_clock::now();
+    solution.auction_utility = session.SolveAuction(solution.auction_assignment, threads);
+    solution.has_auction = true;
+    solution.auction_ms = elapsed_ms(start);
+
+    if (session.Config().Runs(SolverKind::Greedy))
+    {
+        start = std::chrono::steady_clock::now();
+        solution.greedy_utility = session.SolveGreedy(solution.greedy_assignment);
+        solution.has_greedy = true;
+        solution.greedy_ms = elapsed_ms(start);
     }
+    if (exact)
+    {
+        start = std::chrono::steady_clock::now();
+        solution.has_hungarian = session.SolveExact(solution.hungarian_assignment, solution.hungarian_utility, threads);
+        solution.hungarian_ms = elapsed_ms(start);
+    }
+
+    log_dump("auction_assignment", solution.auction_assignment);
+    return solution;
 }
 
-int main()
+json session_stats_to_json(const SessionSolveStats& stats)
+{
+    return {
+        {"components", stats.components},
+        {"reused", stats.reused},
+        {"warm", stats.warm},
+        {"cold", stats.cold},
+        {"moved", stats.moved},
+        {"tasks_changed", stats.tasks_changed},
+        {"relabeled", stats.relabeled}
+    };
+}
+
+// Строка NDJSON-ответа /run_batch для одного экземпляра: поля как в ответе
+// /run_auction плюс "index" экземпляра в пакете, или "index" и "error"
+std::string batch_line(const BatchRunner<Solution>::Item& item, const SolverConfig& config)
+{
+    if (!item.result)
+        return json{{"index", item.index}, {"error", item.error}}.dump() + "\n";
+
+    json meta = solution_meta(*item.result, config);
+    meta["index"] = item.index;
+    return encode_json_response(*item.result, std::move(meta)) + "\n";
+}
+
+// Состояние потокового ответа /run_batch: живёт, пока httplib вызывает провайдер
+struct BatchResponse
+{
+    BatchResponse(SolverPool& pool, BatchOrder order, std::size_t window) : runner(pool, order, window) {}
+
+    BatchRunner<Solution> runner;
+    std::vector<SolverConfig> configs;  // параметры каждого экземпляра - для строки ответа
+    SolverConfig batch_config;
+    std::string order;
+    std::size_t request_bytes = 0;
+    std::size_t response_bytes = 0;
+    std::size_t failed = 0;
+    double parse_us = 0.0;
+    std::chrono::steady_clock::time_point start;
+};
+
+// Клиент потокового ответа отключился - решение прерывается на ближайшем колбэке
+class StreamCancelled : public std::runtime_error
+{
+public:
+    StreamCancelled() : std::runtime_error("stream cancelled") {}
+};
+
+// Состояние потокового ответа /run_auction_stream. Решатель в потоке пула дописывает
+// строки NDJSON, провайдер httplib забирает всё накопленное одним куском
+struct AuctionStream
+{
+    // Предел неотданных данных. Решатель никогда не ждёт медленного клиента: снимки
+    // и события компонент сверх предела пропускаются (их перекрывает событие "auction"
+    // с полным назначением), "auction" и итоговая строка добавляются всегда
+    static constexpr std::size_t max_backlog = 1u << 20;
+
+    std::mutex mutex;
+    std::condition_variable ready;  // появились данные для провайдера
+    std::string pending;       // строки, ещё не отданные провайдеру
+    bool finished = false;     // последняя строка ("result" или "error") уже в pending
+    bool cancelled = false;    // клиент отключился
+    std::size_t events = 0;
+    std::size_t dropped = 0;   // пропущено событий из-за max_backlog
+    double first_event_ms = 0.0;
+    double queue_wait_ms = 0.0;
+    double solve_ms = 0.0;
+
+    // Задаются до отправки в пул и дальше не меняются
+    Coords robot_coords;
+    Coords task_coords;
+    SolverConfig config;
+    std::chrono::steady_clock::duration interval;
+    SolverLane lane = SolverLane::Small;
+    double parse_us = 0.0;
+    std::size_t request_bytes = 0;
+    std::chrono::steady_clock::time_point start;
+
+    // Только в потоке провайдера
+    std::size_t response_bytes = 0;
+
+    [[nodiscard]] double ElapsedMs() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Примет ли поток ещё одно пропускаемое событие; отказ считается в dropped.
+    // Бросает StreamCancelled
+    bool Accepts()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (cancelled)
+            throw StreamCancelled();
+        if (pending.size() < max_backlog)
+            return true;
+        dropped++;
+        return false;
+    }
+
+    // Точка отмены между решателями
+    void ThrowIfCancelled()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (cancelled)
+            throw StreamCancelled();
+    }
+
+    // Строка события; last - итоговая. Не ждёт клиента; бросает StreamCancelled
+    // (кроме итоговой строки)
+    void Push(const std::string& line, bool last = false)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (cancelled && !last)
+                throw StreamCancelled();
+            if (events++ == 0)
+                first_event_ms = ElapsedMs();
+            pending += line;
+            pending += '\n';
+            finished = finished || last;
+        }
+        ready.notify_one();
+    }
+};
+
+int main(int argc, char* argv[])
 {
 #ifdef _WIN32
     SetConsoleOutputCP(CP_UTF8);
@@ -73,13 +688,78 @@ int main()
     std::setlocale(LC_ALL, "en_US.UTF-8");
 #endif
 
-    AuctionAlgo<double> algo;
-    PARAMETRS::min_utility = 1.0;
-    PARAMETRS::max_utility = 30.0;
-    PARAMETRS::visibility_radius = 100.0;
+    // Параметры по умолчанию; запрос может переопределить их полем "config"
+    const SolverConfig default_config;
+
+#ifdef DEBUG
+    Log().SetLevel(LogLevel::Debug);
+#endif
+
+    // --small-threads, --large-threads, --small-queue, --large-queue, --large-cells, --log-level,
+    // --cache-bytes, --cache-ttl-ms, --batch-window, --max-sessions, --session-ttl-ms
+    SolverPoolOptions pool_options;
+    std::size_t cache_bytes = 256u << 20;
+    std::size_t cache_ttl_ms = 30'000;
+    std::size_t batch_window = 0;
+    std::size_t max_sessions = 64;
+    std::size_t session_ttl_ms = 600'000;
+    for (int a = 1; a + 1 < argc; a += 2)
+    {
+        std::string arg = argv[a];
+        LogLevel level;
+        if (arg == "--log-level")
+        {
+            if (ParseLogLevel(argv[a + 1], level))
+                Log().SetLevel(level);
+            else
+                Log().Printf(LogLevel::Warning, "event=bad_option option=%s value=%s", argv[a], argv[a + 1]);
+            continue;
+        }
+
+        std::size_t value = std::stoul(argv[a + 1]);
+        if (arg == "--small-threads")
+            pool_options.small_threads = value;
+        else if (arg == "--large-threads")
+            pool_options.large_threads = value;
+        else if (arg == "--small-queue")
+            pool_options.small_queue = value;
+        else if (arg == "--large-queue")
+            pool_options.large_queue = value;
+        else if (arg == "--large-cells")
+            pool_options.large_cells = value;
+        else if (arg == "--cache-bytes")
+            cache_bytes = value;
+        else if (arg == "--cache-ttl-ms")
+            cache_ttl_ms = value;
+        else if (arg == "--batch-window")
+            batch_window = value;
+        else if (arg == "--max-sessions")
+            max_sessions = value;
+        else if (arg == "--session-ttl-ms")
+            session_ttl_ms = value;
+        else
+            Log().Printf(LogLevel::Warning, "event=bad_option option=%s", argv[a]);
+    }
+
+    SolverPool pool(pool_options);
+
+    // Экземпляров одного пакета в пуле одновременно: по умолчанию вдвое больше потоков,
+    // чтобы потоки не простаивали между задачами
+    if (batch_window == 0)
+        batch_window = 2 * (pool_options.small_threads + pool_options.large_threads);
+    ResultCache<Solution> cache(cache_bytes, std::chrono::milliseconds(cache_ttl_ms), solution_bytes);
+    SessionStore sessions(max_sessions, std::chrono::milliseconds(session_ttl_ms));
 
     httplib::Server svr;
 
+    // Потоки httplib ждут результат пула, поэтому их должно хватать на все места
+    // в полосах, плюс запас для статики и /pool_stats. Остальные запросы получат 503.
+    // Любой запрос к пулу занимает ровно одно место: решатели /run_auction работают
+    // параллельно внутри своей задачи, а не отдельными задачами
+    const std::size_t http_threads = pool_options.small_threads + pool_options.small_queue +
+                                     pool_options.large_threads + pool_options.large_queue + 4;
+    svr.new_task_queue = [http_threads] { return new httplib::ThreadPool(http_threads); };
+
     svr.Get("/", [](const httplib::Request&, httplib::Response& res) {
         std::ifstream file("index.html");
         if (file) {
@@ -93,84 +773,657 @@ int main()
 
     svr.Post("/run_auction", [&](const httplib::Request& req, httplib::Response& res) {
         try {
-            json input = json::parse(req.body);
-            int n = input["n"].get<int>();
-            int m = input["m"].get<int>();
-            std::vector<Point> robot_coords(n);
-            std::vector<Point> task_coords(m);
+            // Бинарное тело - по Content-Type; ответ кодируется так же, как запрос
+            const bool binary = req.get_header_value("Content-Type").rfind(WireFormat::content_type, 0) == 0;
+
+            SolverConfig config;
+            Coords robot_coords;
+            Coords task_coords;
+
+            auto parse_start = std::chrono::steady_clock::now();
+            if (binary)
+                decode_binary_request(req.body, default_config, config, robot_coords, task_coords);
+            else
+                decode_json_request(req.body, default_config, config, robot_coords, task_coords);
+            const double parse_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - parse_start).count();
+
+            const int n = static_cast<int>(robot_coords.size());
+            const int m = static_cast<int>(task_coords.size());
+
+            log_dump("robot_coords", robot_coords);
+            log_dump("task_coords", task_coords);
+
+            // n * m определяет полосу пула; handler ждёт результат, поэтому ссылки на координаты живы
+            const std::size_t cells = static_cast<std::size_t>(n) * m;
+            const SolverLane lane = pool.LaneFor(cells);
+
+            // Одинаковые запросы берут результат из кэша или ждут уже идущего решения
+            CacheOutcome outcome;
+            auto cached = cache.Get(make_cache_key(robot_coords, task_coords, config), [&] {
+                return solve_concurrently(pool, robot_coords, task_coords, config);
+            }, outcome);
+
+            std::shared_ptr<const Solution> result;
+            try
+            {
+                result = cached.get();
+            }
+            catch (const SolverQueueFull&)
+            {
+                Log().Printf(LogLevel::Warning, "event=solve status=503 n=%d m=%d lane=%s",
+                             n, m, lane == SolverLane::Large ? "large" : "small");
+                res.status = 503;
+                res.set_header("Retry-After", "1");
+                res.set_content("{\"error\":\"solver queue is full\"}", "application/json");
+                return;
+            }
+
+            const Solution& solution = *result;
+
+            json meta = solution_meta(solution, config);
+            const bool hit = outcome == CacheOutcome::Hit;
+            if (hit)
+            {
+                // Запрос не решался и не ждал в очереди; времена решателей - от исходного
+                // решения, поэтому тоже обнуляются (набор решателей сохраняется)
+                meta["queue_wait_ms"] = 0.0;
+                meta["solve_ms"] = 0.0;
+                for (auto& solver_ms : meta["solver_ms"])
+                    solver_ms = 0.0;
+            }
+            meta["cache"] = cache_outcome_name(outcome);
+            meta["lane"] = lane == SolverLane::Large ? "large" : "small";
+            meta["parse_us"] = parse_us;
+            meta["request_bytes"] = req.body.size();
+
+            const double queue_wait_ms = meta["queue_wait_ms"].get<double>();
+            const double solve_ms = meta["solve_ms"].get<double>();
+
+            if (binary)
+                res.set_content(encode_binary_response(solution, std::move(meta), n), WireFormat::content_type);
+            else
+                res.set_content(encode_json_response(solution, std::move(meta)), "application/json");
+
+            // Итог запроса - одна строка ключ=значение
+            Log().Printf(LogLevel::Info,
+                         "event=solve status=200 n=%d m=%d lane=%s cache=%s encoding=%s request_bytes=%zu response_bytes=%zu "
+                         "parse_us=%.1f queue_wait_ms=%.3f solve_ms=%.3f auction=%.6f greedy=%.6f hungarian=%.6f "
+                         "auction_ms=%.3f greedy_ms=%.3f hungarian_ms=%.3f radius=%g",
+                         n, m, lane == SolverLane::Large ? "large" : "small", cache_outcome_name(outcome),
+                         binary ? "binary" : "json", req.body.size(), res.body.size(), parse_us,
+                         queue_wait_ms, solve_ms,
+                         solution.has_auction ? solution.auction_utility : std::nan(""),
+                         solution.has_greedy ? solution.greedy_utility : std::nan(""),
+                         solution.has_hungarian ? solution.hungarian_utility : std::nan(""),
+                         hit ? 0.0 : solution.auction_ms, hit ? 0.0 : solution.greedy_ms,
+                         hit ? 0.0 : solution.hungarian_ms, config.visibility_radius);
+        }
+        catch (const std::invalid_argument& e)
+        {
+            // Некорректные параметры запроса
+            Log().Printf(LogLevel::Warning, "event=solve status=400 error=\"%s\"", e.what());
+            res.status = 400;
+            res.set_content(json{{"error", e.what()}}.dump(), "application/json");
+        }
+        catch (const json::exception& e)
+        {
+            // Тело не разбирается или поля не того типа
+            Log().Printf(LogLevel::Warning, "event=solve status=400 error=\"%s\"", e.what());
+            res.status = 400;
+            res.set_content(json{{"error", e.what()}}.dump(), "application/json");
+        }
+        catch (const std::exception& e)
+        {
+            res.status = 500;
+            Log().Printf(LogLevel::Error, "event=solve status=500 error=\"%s\"", e.what());
+            res.set_content("{\"error\":\"" + std::string(e.what()) + "\"}", "application/json");
+        }
+    });
+
+    // Потоковый вариант /run_auction (NDJSON): промежуточные назначения аукциона раз в
+    // interval_ms (параметр запроса, по умолчанию 100), итог каждой компоненты видимости,
+    // назначения аукциона до жадного и венгерского и последней строкой - полный ответ
+    // /run_auction. Кэш результатов не используется: промежуточных событий у него нет
+    svr.Post("/run_auction_stream", [&](const httplib::Request& req, httplib::Response& res) {
+        try {
+            auto stream = std::make_shared<AuctionStream>();
+
+            double interval_ms = 100.0;
+            if (req.has_param("interval_ms"))
+            {
+                try
+                {
+                    interval_ms = std::stod(req.get_param_value("interval_ms"));
+                }
+                catch (const std::exception&)
+                {
+                    throw std::invalid_argument("interval_ms must be a number");
+                }
+                if (!(interval_ms >= 1.0))
+                    throw std::invalid_argument("interval_ms must be at least 1");
+            }
+            stream->interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double, std::milli>(interval_ms));
+
+            const bool binary = req.get_header_value("Content-Type").rfind(WireFormat::content_type, 0) == 0;
+
+            auto parse_start = std::chrono::steady_clock::now();
+            if (binary)
+                decode_binary_request(req.body, default_config, stream->config, stream->robot_coords, stream->task_coords);
+            else
+                decode_json_request(req.body, default_config, stream->config, stream->robot_coords, stream->task_coords);
+            stream->start = std::chrono::steady_clock::now();
+            stream->parse_us = std::chrono::duration<double, std::micro>(stream->start - parse_start).count();
+            stream->request_bytes = req.body.size();
+
+            const std::size_t n = stream->robot_coords.size();
+            const std::size_t m = stream->task_coords.size();
+            const std::size_t cells = n * m;
+            stream->lane = pool.LaneFor(cells);
+
+            // Задача держит stream сама: клиент может отключиться раньше, чем она начнётся
+            const std::size_t threads = pool.JobThreads(stream->lane);
+            auto submitted = pool.TrySubmit(cells, [stream, threads](double queue_wait_ms) {
+                SolveObserver observer;
+                observer.auction.interval = stream->interval;
+                observer.auction.on_progress = [&](const std::vector<int>& assignment, double utility,
+                                                   std::size_t components_done, std::size_t components) {
+                    if (!stream->Accepts())
+                        return;
+                    stream->Push(json{
+                        {"event", "progress"},
+                        {"elapsed_ms", stream->ElapsedMs()},
+                        {"components_done", components_done},
+                        {"components", components},
+                        {"auction_utility", utility},
+                        {"auction_assignment", assignment}
+                    }.dump());
+                };
+                observer.auction.on_component = [&](std::size_t component, const int* robots, const std::vector<int>& tasks) {
+                    if (!stream->Accepts())
+                        return;
+                    stream->Push(json{
+                        {"event", "component"},
+                        {"elapsed_ms", stream->ElapsedMs()},
+                        {"component", component},
+                        {"robots", std::vector<int>(robots, robots + tasks.size())},
+                        {"auction_assignment", tasks}
+                    }.dump());
+                };
+                observer.before_solver = [&] { stream->ThrowIfCancelled(); };
+                observer.on_auction = [&](const Solution& solution) {
+                    stream->Push(json{
+                        {"event", "auction"},
+                        {"elapsed_ms", stream->ElapsedMs()},
+                        {"auction_utility", solution.auction_utility},
+                        {"auction_assignment", solution.auction_assignment}
+                    }.dump());
+                };
+
+                try
+                {
+                    auto start = std::chrono::steady_clock::now();
+                    Solution solution = solve_instance(stream->robot_coords, stream->task_coords, stream->config, threads, &observer);
+                    solution.queue_wait_ms = queue_wait_ms;
+                    solution.solve_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+                    json meta = solution_meta(solution, stream->config);
+                    meta["event"] = "result";
+                    meta["elapsed_ms"] = stream->ElapsedMs();
+                    meta["lane"] = stream->lane == SolverLane::Large ? "large" : "small";
+                    meta["parse_us"] = stream->parse_us;
+                    meta["request_bytes"] = stream->request_bytes;
+
+                    {
+                        std::lock_guard<std::mutex> lock(stream->mutex);
+                        stream->queue_wait_ms = solution.queue_wait_ms;
+                        stream->solve_ms = solution.solve_ms;
+                        meta["dropped_events"] = stream->dropped;
+                    }
+                    stream->Push(encode_json_response(solution, std::move(meta)), true);
+                }
+                catch (const StreamCancelled&)
+                {
+                    Log().Printf(LogLevel::Info, "event=stream status=cancelled n=%zu m=%zu elapsed_ms=%.3f",
+                                 stream->robot_coords.size(), stream->task_coords.size(), stream->ElapsedMs());
+                }
+                catch (const std::exception& e)
+                {
+                    Log().Printf(LogLevel::Error, "event=stream status=500 error=\"%s\"", e.what());
+                    stream->Push(json{{"event", "error"}, {"error", e.what()}}.dump(), true);
+                }
+            });
+
+            if (!submitted)
+            {
+                Log().Printf(LogLevel::Warning, "event=stream status=503 n=%zu m=%zu lane=%s",
+                             n, m, stream->lane == SolverLane::Large ? "large" : "small");
+                res.status = 503;
+                res.set_header("Retry-After", "1");
+                res.set_content("{\"error\":\"solver queue is full\"}", "application/json");
+                return;
+            }
+
+            res.set_chunked_content_provider("application/x-ndjson", [stream](std::size_t, httplib::DataSink& sink) {
+                std::string chunk;
+                bool last;
+                {
+                    std::unique_lock<std::mutex> lock(stream->mutex);
+                    stream->ready.wait(lock, [&] { return !stream->pending.empty() || stream->finished; });
+                    chunk.swap(stream->pending);
+                    last = stream->finished;
+                }
+                stream->response_bytes += chunk.size();
+
+                if (!last)
+                    return sink.write(chunk.data(), chunk.size());
+
+                Log().Printf(LogLevel::Info,
+                             "event=stream status=200 n=%zu m=%zu lane=%s events=%zu dropped=%zu first_event_ms=%.3f "
+                             "request_bytes=%zu response_bytes=%zu parse_us=%.1f queue_wait_ms=%.3f solve_ms=%.3f",
+                             stream->robot_coords.size(), stream->task_coords.size(),
+                             stream->lane == SolverLane::Large ? "large" : "small", stream->events, stream->dropped,
+                             stream->first_event_ms,
+                             stream->request_bytes, stream->response_bytes, stream->parse_us,
+                             stream->queue_wait_ms, stream->solve_ms);
+
+                sink.write(chunk.data(), chunk.size());
+                sink.done();
+                return true;
+            }, [stream](bool success) {
+                // Клиент отключился: решение прервётся на ближайшем событии или перед следующим решателем
+                if (!success)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(stream->mutex);
+                        stream->cancelled = true;
+                    }
+                    Log().Printf(LogLevel::Warning, "event=stream status=aborted n=%zu m=%zu response_bytes=%zu",
+                                 stream->robot_coords.size(), stream->task_coords.size(), stream->response_bytes);
+                }
+            });
+        }
+        catch (const std::invalid_argument& e)
+        {
+            Log().Printf(LogLevel::Warning, "event=stream status=400 error=\"%s\"", e.what());
+            res.status = 400;
+            res.set_content(json{{"error", e.what()}}.dump(), "application/json");
+        }
+        catch (const json::exception& e)
+        {
+            Log().Printf(LogLevel::Warning, "event=stream status=400 error=\"%s\"", e.what());
+            res.status = 400;
+            res.set_content(json{{"error", e.what()}}.dump(), "application/json");
+        }
+    });
+
+    svr.Post("/run_batch", [&](const httplib::Request& req, httplib::Response& res) {
+        try {
+            auto parse_start = std::chrono::steady_clock::now();
+
+            std::vector<BatchInstance> instances;
+            json batch_overrides;
+            std::string order;
+            ParseBatchRequest(req.body, instances, batch_overrides, order);
 
-            std::cout << "Size: " << n << 'x' << m << '\n';
+            auto batch = std::make_shared<BatchResponse>(
+                pool, order == "input" ? BatchOrder::Input : BatchOrder::Completion, batch_window);
+            batch->batch_config = config_from_json(batch_overrides, default_config);
+            batch->order = order;
+            batch->request_bytes = req.body.size();
+            batch->configs.resize(instances.size());
 
-            std::cout << "Robot_coords: \n";
-            for (int i = 0; i < n; ++i)
+            // Экземпляр с ошибкой разбора или параметров не решается, но остаётся в ответе
+            for (std::size_t i = 0; i < instances.size(); ++i)
             {
-                robot_coords[i] = {input["robot_coords"][i][0].get<double>(), input["robot_coords"][i][1].get<double>()};
-                std::cout << robot_coords[i].x << ' ' << robot_coords[i].y << '\n';
+                BatchInstance& instance = instances[i];
+                if (instance.error.empty())
+                {
+                    try
+                    {
+                        batch->configs[i] = config_from_json(instance.config, batch->batch_config);
+                    }
+                    catch (const std::invalid_argument& e)
+                    {
+                        instance.error = e.what();
+                    }
+                    catch (const json::exception& e)
+                    {
+                        instance.error = e.what();
+                    }
+                }
+
+                if (!instance.error.empty())
+                {
+                    batch->runner.AddError(std::move(instance.error));
+                    continue;
+                }
+
+                const std::size_t cells = instance.robots.size() * instance.tasks.size();
+                batch->runner.Add(cells, [robot_coords = std::move(instance.robots), task_coords = std::move(instance.tasks),
+                                          config = batch->configs[i], threads = pool.JobThreads(pool.LaneFor(cells))](double queue_wait_ms) {
+                    auto start = std::chrono::steady_clock::now();
+                    Solution solution = solve_instance(robot_coords, task_coords, config, threads);
+                    solution.queue_wait_ms = queue_wait_ms;
+                    solution.solve_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                    return solution;
+                });
             }
 
-            std::cout << "Task_coords: \n";
-            for (int j = 0; j < m; ++j)
+            batch->start = std::chrono::steady_clock::now();
+            batch->parse_us = std::chrono::duration<double, std::micro>(batch->start - parse_start).count();
+
+            // NDJSON: строка на экземпляр, последней - итог пакета. Готовые к этому моменту
+            // строки уходят одним куском, чтобы не писать в сокет по строке
+            res.set_chunked_content_provider("application/x-ndjson", [batch](std::size_t, httplib::DataSink& sink) {
+                BatchRunner<Solution>::Item item;
+                std::string chunk;
+
+                if (!batch->runner.Next(item))
+                {
+                    const double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - batch->start).count();
+                    chunk = json{{"summary", {
+                        {"instances", batch->runner.Size()},
+                        {"failed", batch->failed},
+                        {"order", batch->order},
+                        {"parse_us", batch->parse_us},
+                        {"elapsed_ms", elapsed_ms},
+                        {"config", config_to_json(batch->batch_config)}
+                    }}}.dump() + "\n";
+                    batch->response_bytes += chunk.size();
+
+                    Log().Printf(LogLevel::Info,
+                                 "event=batch status=200 order=%s instances=%zu failed=%zu request_bytes=%zu response_bytes=%zu "
+                                 "parse_us=%.1f elapsed_ms=%.3f",
+                                 batch->order.c_str(), batch->runner.Size(), batch->failed, batch->request_bytes,
+                                 batch->response_bytes, batch->parse_us, elapsed_ms);
+
+                    sink.write(chunk.data(), chunk.size());
+                    sink.done();
+                    return true;
+                }
+
+                do
+                {
+                    if (!item.result)
+                        batch->failed++;
+                    chunk += batch_line(item, batch->configs[item.index]);
+                } while (chunk.size() < (64u << 10) && batch->runner.TryNext(item));
+
+                batch->response_bytes += chunk.size();
+                return sink.write(chunk.data(), chunk.size());
+            }, [batch](bool success) {
+                // Клиент отключился: ещё не начатые экземпляры будут пропущены
+                if (!success)
+                    Log().Printf(LogLevel::Warning, "event=batch status=aborted instances=%zu response_bytes=%zu",
+                                 batch->runner.Size(), batch->response_bytes);
+            });
+        }
+        catch (const std::invalid_argument& e)
+        {
+            // Пакет не разобран целиком - ошибки отдельных экземпляров сюда не попадают
+            Log().Printf(LogLevel::Warning, "event=batch status=400 error=\"%s\"", e.what());
+            res.status = 400;
+            res.set_content(json{{"error", e.what()}}.dump(), "application/json");
+        }
+        catch (const json::exception& e)
+        {
+            Log().Printf(LogLevel::Warning, "event=batch status=400 error=\"%s\"", e.what());
+            res.status = 400;
+            res.set_content(json{{"error", e.what()}}.dump(), "application/json");
+        }
+    });
+
+    // Сессии планирования: координаты передаются один раз, дальше - только изменения
+    svr.Post("/sessions", [&](const httplib::Request& req, httplib::Response& res) {
+        try {
+            const bool binary = req.get_header_value("Content-Type").rfind(WireFormat::content_type, 0) == 0;
+
+            SolverConfig config;
+            Coords robot_coords;
+            Coords task_coords;
+            if (binary)
+                decode_binary_request(req.body, default_config, config, robot_coords, task_coords);
+            else
+                decode_json_request(req.body, default_config, config, robot_coords, task_coords);
+
+            const std::size_t n = robot_coords.size();
+            const std::size_t m = task_coords.size();
+            auto session = std::make_shared<PlanningSession>(std::move(robot_coords), std::move(task_coords), config);
+            const bool dense = session->Dense();
+
+            const std::string id = sessions.Create(std::move(session));
+            if (id.empty())
             {
-                task_coords[j] = {input["task_coords"][j][0].get<double>(), input["task_coords"][j][1].get<double>()};
-                std::cout << task_coords[j].x << ' ' << task_coords[j].y << '\n';
+                Log().Printf(LogLevel::Warning, "event=session_create status=503 error=\"too many sessions\"");
+                res.status = 503;
+                res.set_header("Retry-After", "1");
+                res.set_content("{\"error\":\"too many sessions\"}", "application/json");
+                return;
             }
 
-            std::vector<std::vector<double>> alpha;
-            std::vector<std::vector<int>> visibility_robots;
-            generate_instance(n, m, robot_coords, task_coords, alpha, visibility_robots);
+            Log().Printf(LogLevel::Info, "event=session_create status=201 session=%s n=%zu m=%zu dense=%d sessions=%zu",
+                         id.c_str(), n, m, dense ? 1 : 0, sessions.Size());
+            res.status = 201;
+            res.set_content(json{
+                {"session_id", id},
+                {"n", n},
+                {"m", m},
+                {"dense", dense},
+                {"config", config_to_json(config)}
+            }.dump(), "application/json");
+        }
+        catch (const std::invalid_argument& e)
+        {
+            Log().Printf(LogLevel::Warning, "event=session_create status=400 error=\"%s\"", e.what());
+            res.status = 400;
+            res.set_content(json{{"error", e.what()}}.dump(), "application/json");
+        }
+        catch (const json::exception& e)
+        {
+            Log().Printf(LogLevel::Warning, "event=session_create status=400 error=\"%s\"", e.what());
+            res.status = 400;
+            res.set_content(json{{"error", e.what()}}.dump(), "application/json");
+        }
+    });
+
+    svr.Patch(R"(/sessions/([0-9a-f]+))", [&](const httplib::Request& req, httplib::Response& res) {
+        const std::string id = req.matches[1];
+        auto session = sessions.Find(id);
+        if (!session)
+        {
+            res.status = 404;
+            res.set_content("{\"error\":\"unknown session\"}", "application/json");
+            return;
+        }
+
+        try {
+            const SessionUpdate update = session_update_from_json(json::parse(req.body));
 
-            std::vector<int> auction_assignment;
-            double auction_utility = algo.Start(n, m, alpha, visibility_robots, PARAMETRS::epsilon, auction_assignment);
+            std::lock_guard<std::mutex> lock(session->Mutex());
+            session->Apply(update);
+
+            Log().Printf(LogLevel::Info, "event=session_update status=200 session=%s moved=%zu removed=%zu added=%zu n=%zu m=%zu",
+                         id.c_str(), update.moved_robots.size(), update.remove_tasks.size(), update.add_tasks.size(),
+                         session->Robots().size(), session->Tasks().size());
+            res.set_content(json{
+                {"n", session->Robots().size()},
+                {"m", session->Tasks().size()},
+                {"dense", session->Dense()}
+            }.dump(), "application/json");
+        }
+        catch (const std::invalid_argument& e)
+        {
+            Log().Printf(LogLevel::Warning, "event=session_update status=400 session=%s error=\"%s\"", id.c_str(), e.what());
+            res.status = 400;
+            res.set_content(json{{"error", e.what()}}.dump(), "application/json");
+        }
+        catch (const json::exception& e)
+        {
+            Log().Printf(LogLevel::Warning, "event=session_update status=400 session=%s error=\"%s\"", id.c_str(), e.what());
+            res.status = 400;
+            res.set_content(json{{"error", e.what()}}.dump(), "application/json");
+        }
+    });
 
-            std::cout << "Auction assignment: ";
-            for (int i = 0; i < auction_assignment.size(); ++i) {
-                std::cout << auction_assignment[i] << " ";
+    // Тело необязательно: {"exact": true} добавляет венгерский алгоритм
+    svr.Post(R"(/sessions/([0-9a-f]+)/solve)", [&](const httplib::Request& req, httplib::Response& res) {
+        const std::string id = req.matches[1];
+        auto session = sessions.Find(id);
+        if (!session)
+        {
+            res.status = 404;
+            res.set_content("{\"error\":\"unknown session\"}", "application/json");
+            return;
+        }
+
+        try {
+            bool exact = false;
+            if (!req.body.empty())
+            {
+                const json body = json::parse(req.body);
+                if (!body.is_object())
+                    throw std::invalid_argument("solve options must be an object");
+                for (const auto& [key, value] : body.items())
+                {
+                    if (key == "exact")
+                        exact = value.get<bool>();
+                    else
+                        throw std::invalid_argument("unknown solve option: " + key);
+                }
+            }
+
+            std::size_t n, m;
+            {
+                std::lock_guard<std::mutex> lock(session->Mutex());
+                n = session->Robots().size();
+                m = session->Tasks().size();
             }
-            std::cout << "\nAuction Utility: " << auction_utility << std::endl;
+            const std::size_t cells = n * m;
+            const SolverLane lane = pool.LaneFor(cells);
 
-            std::vector<int> hungarian_assignment;
-            std::vector<int> N_max(m, 1);
-            HungarianAlgo<double> hungarian_algo(n, m, alpha, N_max);
-            double hungarian_utility = hungarian_algo.Start(hungarian_assignment);
+            // Решение идёт в потоке пула под замком сессии; handler ждёт его, поэтому
+            // ссылки на локальные переменные живы
+            SessionSolveStats stats;
+            auto pending = pool.TrySubmit(cells, [&](double queue_wait_ms) {
+                std::lock_guard<std::mutex> lock(session->Mutex());
+                auto start = std::chrono::steady_clock::now();
+                Solution solution = solve_session(*session, exact, pool.JobThreads(lane));
+                solution.queue_wait_ms = queue_wait_ms;
+                solution.solve_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                stats = session->LastSolve();
+                return solution;
+            });
 
-            std::cout << "Hungarian assignment: ";
-            for (int i = 0; i < hungarian_assignment.size(); ++i) {
-                std::cout << hungarian_assignment[i] << " ";
+            if (!pending)
+            {
+                Log().Printf(LogLevel::Warning, "event=session_solve status=503 session=%s lane=%s",
+                             id.c_str(), lane == SolverLane::Large ? "large" : "small");
+                res.status = 503;
+                res.set_header("Retry-After", "1");
+                res.set_content("{\"error\":\"solver queue is full\"}", "application/json");
+                return;
             }
-            std::cout << "\nHungarian Utility: " << hungarian_utility << std::endl;
 
-            json response;
-            response["auction_assignment"] = auction_assignment;
-            response["auction_utility"] = auction_utility;
-            response["hungarian_assignment"] = hungarian_assignment;
-            response["hungarian_utility"] = hungarian_utility;
-            response["visibility_radius"] = PARAMETRS::visibility_radius;
+            const Solution solution = pending->get();
+            const SolverConfig& config = session->Config();
+
+            json meta = solution_meta(solution, config);
+            meta["session"] = session_stats_to_json(stats);
+            meta["lane"] = lane == SolverLane::Large ? "large" : "small";
+            res.set_content(encode_json_response(solution, std::move(meta)), "application/json");
 
-            res.set_content(response.dump(), "application/json");
+            Log().Printf(LogLevel::Info,
+                         "event=session_solve status=200 session=%s n=%zu m=%zu lane=%s components=%zu reused=%zu warm=%zu cold=%zu "
+                         "moved=%zu queue_wait_ms=%.3f solve_ms=%.3f auction=%.6f greedy=%.6f hungarian=%.6f",
+                         id.c_str(), n, m,
+                         lane == SolverLane::Large ? "large" : "small", stats.components, stats.reused, stats.warm, stats.cold,
+                         stats.moved, solution.queue_wait_ms, solution.solve_ms, solution.auction_utility,
+                         solution.has_greedy ? solution.greedy_utility : std::nan(""),
+                         solution.has_hungarian ? solution.hungarian_utility : std::nan(""));
+        }
+        catch (const std::invalid_argument& e)
+        {
+            Log().Printf(LogLevel::Warning, "event=session_solve status=400 session=%s error=\"%s\"", id.c_str(), e.what());
+            res.status = 400;
+            res.set_content(json{{"error", e.what()}}.dump(), "application/json");
+        }
+        catch (const json::exception& e)
+        {
+            Log().Printf(LogLevel::Warning, "event=session_solve status=400 session=%s error=\"%s\"", id.c_str(), e.what());
+            res.status = 400;
+            res.set_content(json{{"error", e.what()}}.dump(), "application/json");
         }
         catch (const std::exception& e)
         {
+            Log().Printf(LogLevel::Error, "event=session_solve status=500 session=%s error=\"%s\"", id.c_str(), e.what());
             res.status = 500;
-            std::cerr << "Error: " << e.what() << std::endl;
-            res.set_content("{\"error\":\"" + std::string(e.what()) + "\"}", "application/json");
+            res.set_content(json{{"error", e.what()}}.dump(), "application/json");
+        }
+    });
+
+    svr.Delete(R"(/sessions/([0-9a-f]+))", [&](const httplib::Request& req, httplib::Response& res) {
+        const std::string id = req.matches[1];
+        if (!sessions.Erase(id))
+        {
+            res.status = 404;
+            res.set_content("{\"error\":\"unknown session\"}", "application/json");
+            return;
+        }
+
+        Log().Printf(LogLevel::Info, "event=session_delete status=204 session=%s sessions=%zu", id.c_str(), sessions.Size());
+        res.status = 204;
+    });
+
+    svr.Get("/cache_stats", [&](const httplib::Request&, httplib::Response& res) {
+        CacheStats stats = cache.Stats();
+        res.set_content(json{
+            {"entries", stats.entries},
+            {"bytes", stats.bytes},
+            {"max_bytes", cache_bytes},
+            {"ttl_ms", cache_ttl_ms},
+            {"hits", stats.hits},
+            {"joined", stats.joined},
+            {"misses", stats.misses},
+            {"evictions", stats.evictions},
+            {"expirations", stats.expirations}
+        }.dump(), "application/json");
+    });
+
+    svr.Get("/pool_stats", [&](const httplib::Request&, httplib::Response& res) {
+        json stats;
+        for (SolverLane lane : {SolverLane::Small, SolverLane::Large})
+        {
+            SolverLaneStats lane_stats = pool.Stats(lane);
+            stats[lane == SolverLane::Large ? "large" : "small"] = {
+                {"workers", lane_stats.workers},
+                {"job_threads", lane_stats.job_threads},
+                {"queued", lane_stats.queued},
+                {"running", lane_stats.running},
+                {"reserved", lane_stats.reserved},
+                {"completed", lane_stats.completed},
+                {"rejected", lane_stats.rejected}
+            };
         }
+        stats["large_cells"] = pool.LargeCells();
+        res.set_content(stats.dump(), "application/json");
     });
 
-    svr.Options("/run_auction", [](const httplib::Request&, httplib::Response& res) {
+    svr.Options(R"(/(run_auction|run_auction_stream|run_batch|sessions.*))", [](const httplib::Request&, httplib::Response& res) {
         res.set_header("Access-Control-Allow-Origin", "*");
-        res.set_header("Access-Control-Allow-Methods", "POST, GET, OPTIONS");
-        res.set_header("Access-Control-Allow-Headers", "Content-Type");
+        res.set_header("Access-Control-Allow-Methods", "POST, GET, PATCH, DELETE, OPTIONS");
+        res.set_header("Access-Control-Allow-Headers", "Content-Type, Accept");
         res.status = 200;
     });
 
     if (!std::filesystem::exists("index.html")) {
-        std::cerr << "Error: index.html not found in build folder\n";
+        Log().Write(LogLevel::Error, "event=startup error=\"index.html not found in build folder\"");
         return 1;
     }
 
     open_browser("http://localhost:8000");
 
-    std::cout << "Starting server at http://localhost:8000\n";
+    Log().Write(LogLevel::Info, "event=startup url=http://localhost:8000");
     svr.listen("localhost", 8000);
 
     return 0;
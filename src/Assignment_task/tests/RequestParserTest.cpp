@@ -0,0 +1,136 @@
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "../RequestParser.hpp"
+#include "TestCheck.hpp"
+
+namespace
+{
+
+bool Rejected(const std::string& body, Coords& robots, Coords& tasks)
+{
+    nlohmann::json config;
+    try
+    {
+        ParseAuctionRequest(body, robots, tasks, config);
+    }
+    catch (const std::invalid_argument&)
+    {
+        return true;
+    }
+    return false;
+}
+
+// Память под точки ограничена тем, что может вместить тело, а не объявленными n и m
+void CheckBounded(const std::string& body, const Coords& robots, const Coords& tasks)
+{
+    const std::size_t limit = body.size() / AuctionRequestSax::min_point_bytes + 1;
+    CHECK(robots.x.capacity() <= limit && robots.y.capacity() <= limit);
+    CHECK(tasks.x.capacity() <= limit && tasks.y.capacity() <= limit);
+}
+
+void CheckValid()
+{
+    // n и m до массивов и после них
+    for (const std::string& body : {
+             std::string(R"({"n": 2, "m": 1, "robot_coords": [[1, 2], [3.5, -4]], "task_coords": [[5, 6]], "config": {"alpha": 2}})"),
+             std::string(R"({"robot_coords": [[1, 2], [3.5, -4]], "task_coords": [[5, 6]], "m": 1, "n": 2, "config": {"alpha": 2}})")})
+    {
+        Coords robots;
+        Coords tasks;
+        nlohmann::json config;
+        ParseAuctionRequest(body, robots, tasks, config);
+
+        CHECK(robots.size() == 2 && tasks.size() == 1);
+        CHECK(robots.y.size() == 2 && tasks.y.size() == 1);
+        CHECK(robots.x[0] == 1 && robots.y[0] == 2 && robots.x[1] == 3.5 && robots.y[1] == -4);
+        CHECK(tasks.x[0] == 5 && tasks.y[0] == 6);
+        CHECK(config["alpha"] == 2);
+    }
+}
+
+void CheckDeclaredSizes()
+{
+    // Огромные n и m без точек: отказ без выделения под объявленный размер
+    for (const std::string& body : {
+             std::string(R"({"n": 2147483647, "m": 2147483647, "robot_coords": [], "task_coords": []})"),
+             std::string(R"({"n": 2147483647, "m": 2147483647})"),
+             std::string(R"({"n": 2147483647, "m": 1, "robot_coords": [[0, 0], [1, 1]], "task_coords": [[2, 2]]})")})
+    {
+        Coords robots;
+        Coords tasks;
+        CHECK(Rejected(body, robots, tasks));
+        CheckBounded(body, robots, tasks);
+    }
+
+    Coords robots;
+    Coords tasks;
+
+    // Точек больше или меньше, чем объявлено
+    CHECK(Rejected(R"({"n": 1, "m": 1, "robot_coords": [[0, 0], [1, 1]], "task_coords": [[2, 2]]})", robots, tasks));
+    CHECK(Rejected(R"({"n": 3, "m": 1, "robot_coords": [[0, 0], [1, 1]], "task_coords": [[2, 2]]})", robots, tasks));
+    CHECK(Rejected(R"({"robot_coords": [[0, 0], [1, 1]], "task_coords": [[2, 2]], "n": 1, "m": 1})", robots, tasks));
+    CHECK(Rejected(R"({"robot_coords": [[0, 0]], "task_coords": [[2, 2]], "n": 1})", robots, tasks));
+
+    // Плохие n, m и точки
+    CHECK(Rejected(R"({"n": -1, "m": 0, "robot_coords": [], "task_coords": []})", robots, tasks));
+    CHECK(Rejected(R"({"n": 2147483648, "m": 0, "robot_coords": [], "task_coords": []})", robots, tasks));
+    CHECK(Rejected(R"({"n": 1, "m": 0, "robot_coords": [[0]], "task_coords": []})", robots, tasks));
+    CHECK(Rejected(R"({"n": 1, "m": 0, "robot_coords": [[0, 1, 2]], "task_coords": []})", robots, tasks));
+}
+
+// Пакет: элемент с огромным n без точек - ошибка элемента, не выделение памяти
+void CheckBatch()
+{
+    std::string body = R"({"instances": [)"
+                       R"({"n": 2147483647, "m": 2147483647, "robot_coords": [], "task_coords": []},)"
+                       R"({"n": 1, "m": 2, "robot_coords": [[1, 2]], "task_coords": [[3, 4], [5, 6]]},)"
+                       R"({"n": 2147483647, "m": 1, "robot_coords": [[0, 0]], "task_coords": [[1, 1]]}]})";
+
+    std::vector<BatchInstance> instances;
+    nlohmann::json config;
+    std::string order;
+    ParseBatchRequest(body, instances, config, order);
+
+    CHECK(instances.size() == 3);
+    if (instances.size() == 3)
+    {
+        CHECK(!instances[0].error.empty() && instances[0].robots.x.capacity() == 0);
+        CHECK(instances[1].error.empty());
+        CHECK(instances[1].robots.size() == 1 && instances[1].tasks.size() == 2);
+        CHECK(instances[1].tasks.x[1] == 5 && instances[1].tasks.y[1] == 6);
+        CHECK(!instances[2].error.empty() && instances[2].robots.x.capacity() == 0);
+    }
+
+    // Много маленьких элементов с огромными n и m: суммарный резерв всех
+    // элементов ограничен телом, а не n * число элементов
+    body = R"({"instances": [)";
+    for (int i = 0; i < 5000; ++i)
+    {
+        body += i % 2 ? R"({"n": 2147483647, "m": 2147483647, "robot_coords": [], "task_coords": []},)"
+                      : R"({"n": 1, "m": 1, "robot_coords": [[0, 0]], "task_coords": [[1, 1]]},)";
+    }
+    body += R"({"n": 2147483647, "m": 2147483647}]})";
+    ParseBatchRequest(body, instances, config, order);
+
+    CHECK(instances.size() == 5001);
+    std::size_t reserved = 0;
+    for (std::size_t i = 0; i < instances.size(); ++i)
+    {
+        CHECK(instances[i].error.empty() == (i % 2 == 0 && i < 5000));
+        reserved += instances[i].robots.x.capacity() + instances[i].tasks.x.capacity();
+    }
+    CHECK(reserved <= body.size() / AuctionRequestSax::min_point_bytes + 1);
+}
+
+}
+
+int main()
+{
+    CheckValid();
+    CheckDeclaredSizes();
+    CheckBatch();
+
+    return TestResult();
+}
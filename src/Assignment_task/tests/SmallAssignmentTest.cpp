@@ -0,0 +1,87 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../SmallAssignment.hpp"
+#include "TestCheck.hpp"
+
+namespace
+{
+
+std::vector<std::vector<double>> RandomUtilities(int n, int m, std::mt19937& generator)
+{
+    std::uniform_real_distribution<double> utility(0.0, 30.0);
+    std::vector<std::vector<double>> alpha(n, std::vector<double>(m));
+    for (auto& row : alpha)
+        for (double& value : row)
+            value = utility(generator);
+    return alpha;
+}
+
+// Эталон: квадратная задача max(n, m) x max(n, m), недостающие строки или столбцы -
+// нулевые. Полезности неотрицательны, поэтому оптимум совпадает с прямоугольным,
+// а квадратный случай HungarianAlgo решает без транспонирования
+double PaddedOptimum(int n, int m, const std::vector<std::vector<double>>& alpha)
+{
+    const int size = std::max(n, m);
+    std::vector<std::vector<double>> square(size, std::vector<double>(size, 0.0));
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < m; ++j)
+            square[i][j] = alpha[i][j];
+
+    std::vector<int> N_max(size, 1);
+    std::vector<int> assignment;
+    HungarianAlgo<double> hungarian(size, size, square, N_max);
+    return hungarian.Start(assignment);
+}
+
+void CheckExact(int n, int m, std::mt19937& generator)
+{
+    std::vector<std::vector<double>> alpha = RandomUtilities(n, m, generator);
+    const std::vector<std::vector<double>> original = alpha;
+
+    std::vector<int> assignment;
+    const double value = SolveAssignmentExact(n, m, alpha, assignment);
+
+    // Назначение корректно: каждая задача не больше чем у одного робота,
+    // занято min(n, m) пар, сумма совпадает с возвращённым значением
+    CHECK(static_cast<int>(assignment.size()) == n);
+    std::vector<bool> taken(m, false);
+    int pairs = 0;
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i)
+    {
+        const int task = assignment[i];
+        if (task == -1)
+            continue;
+        CHECK(task >= 0 && task < m);
+        if (task < 0 || task >= m)
+            continue;
+        CHECK(!taken[task]);
+        taken[task] = true;
+        ++pairs;
+        sum += original[i][task];
+    }
+    CHECK(pairs == std::min(n, m));
+    CHECK(std::abs(sum - value) < 1e-9);
+    CHECK(std::abs(value - PaddedOptimum(n, m, original)) < 1e-9);
+}
+
+}
+
+int main()
+{
+    std::mt19937 generator(28);
+
+    // Фиксированные массивы SmallAssignment<N>: n > m, n < m, квадрат
+    for (auto [n, m] : {std::pair{4, 2}, {5, 3}, {6, 3}, {8, 5}, {12, 7}, {16, 9}, {16, 1}, {3, 7}, {10, 10}})
+        for (int repeat = 0; repeat < 20; ++repeat)
+            CheckExact(n, m, generator);
+
+    // HungarianAlgo, max(n, m) > 16: при n > m раньше зацикливался
+    for (auto [n, m] : {std::pair{17, 16}, {18, 3}, {20, 17}, {40, 25}, {64, 1}, {25, 40}, {30, 30}})
+        for (int repeat = 0; repeat < 5; ++repeat)
+            CheckExact(n, m, generator);
+
+    return TestResult();
+}
@@ -0,0 +1,73 @@
+#include <cmath>
+#include <limits>
+#include <string>
+#include <stdexcept>
+
+#include "../WireFormat.hpp"
+#include "TestCheck.hpp"
+
+namespace
+{
+
+Coords MakeCoords(std::initializer_list<double> xs, std::initializer_list<double> ys)
+{
+    Coords coords;
+    coords.x = xs;
+    coords.y = ys;
+    return coords;
+}
+
+bool Rejected(const std::string& body)
+{
+    Coords robots;
+    Coords tasks;
+    std::string config;
+    try
+    {
+        WireFormat::DecodeRequest(body, robots, tasks, config);
+    }
+    catch (const std::invalid_argument&)
+    {
+        return true;
+    }
+    return false;
+}
+
+void CheckRoundTrip()
+{
+    const Coords robots = MakeCoords({1.0, -2.5}, {3.0, 4.0});
+    const Coords tasks = MakeCoords({5.0}, {-6.0});
+    const std::string body = WireFormat::EncodeRequest(robots, tasks, R"({"alpha":2})");
+
+    Coords decoded_robots;
+    Coords decoded_tasks;
+    std::string config;
+    WireFormat::DecodeRequest(body, decoded_robots, decoded_tasks, config);
+
+    CHECK(decoded_robots.x == robots.x && decoded_robots.y == robots.y);
+    CHECK(decoded_tasks.x == tasks.x && decoded_tasks.y == tasks.y);
+    CHECK(config == R"({"alpha":2})");
+}
+
+// Координаты, которых нет в JSON, отвергаются, где бы они ни стояли
+void CheckNonFinite()
+{
+    for (double bad : {std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(),
+                       -std::numeric_limits<double>::infinity()})
+    {
+        CHECK(Rejected(WireFormat::EncodeRequest(MakeCoords({bad}, {0.0}), MakeCoords({1.0}, {1.0}))));
+        CHECK(Rejected(WireFormat::EncodeRequest(MakeCoords({0.0}, {bad}), MakeCoords({1.0}, {1.0}))));
+        CHECK(Rejected(WireFormat::EncodeRequest(MakeCoords({0.0}, {0.0}), MakeCoords({1.0, bad}, {1.0, 2.0}))));
+        CHECK(Rejected(WireFormat::EncodeRequest(MakeCoords({0.0}, {0.0}), MakeCoords({1.0}, {bad}))));
+    }
+}
+
+}
+
+int main()
+{
+    CheckRoundTrip();
+    CheckNonFinite();
+
+    return TestResult();
+}
@@ -19,6 +19,9 @@ public:
     void Update(std::size_t n, std::size_t m, std::vector<std::vector<T>>& D, std::vector<int>& N);
     T Start(int n, int m, const vector<vector<T>>& alpha, double epsilon, vector<int>& assignment);
 
+    // Цены задач после последнего Start - двойственные переменные для Certificate
+    [[nodiscard]] const std::vector<T>& Prices() const noexcept { return prices; }
+
 private:
     [[nodiscard]] bool isUsedRows() const noexcept;
     [[nodiscard]] bool isUsedCols() const noexcept;
@@ -41,6 +44,7 @@ private:
     std::vector<bool> used_cols;
 
     std::map<std::size_t, std::size_t> distribution_plan;
+    std::vector<T> prices;
 
     T answer = T(0);
 };
@@ -60,7 +64,7 @@ template<typename T>
 T AuctionAlgo<T>::Start(int n, int m, const std::vector<std::vector<T>>& alpha, double epsilon, std::vector<int>& assignment)
 {
     // Инициализация цен задач
-    std::vector<T> prices(m, T(0));
+    prices.assign(m, T(0));
 
     // Инициализация назначений (робот -> задача)
     assignment.resize(n, -1); // Изначально ни один робот не назначен
@@ -10,6 +10,8 @@
 #include <limits>
 #include <climits>
 
+#include "LocalImprovement.hpp"
+
 //15 13 8
 //21 19 5
 //20 21 14
@@ -31,8 +33,6 @@ private:
     [[nodiscard]]bool notNull(const std::vector<F>& v) const noexcept;
 
     void Step_0();
-    bool Step_1_2();
-    bool Step_3_4();
 
     void printMatrix(const std::vector<std::vector<T>>& matrix) const;
 
@@ -102,34 +102,21 @@ T COI_3_1<T>::Start()
 {
     Step_0();
 
-    bool step_1_2 = true;
-    bool step_3_4 = true;
-
-    while(step_1_2 || step_3_4)
+    std::vector<int> assignment(num_rows, -1);
+    for(auto& elem : distribution_plan)
     {
-        step_1_2 = false;
-        step_3_4 = false;
-
-        if(Step_1_2())
-        {
-            step_1_2 = true;
-            continue;
-        }
-        else
-        {
-            while(true)
-            {
-                if(!Step_3_4()) {
-                    break;
-                }
-                else step_3_4 = true;
-            }
-        }
+        assignment[elem.first] = static_cast<int>(elem.second);
     }
 
-    for(auto& elem : distribution_plan)
+    // Шаги 1-2 (попарный обмен) и 3-4 (циклы) выполняет общий локальный поиск.
+    // Перевод на свободные столбцы выключен: при m > n он менял бы ответы COI_3_1
+    LocalImprovement<T> improver(false);
+    (void)improver.Start(num_rows, num_cols, cost, assignment);
+
+    for(std::size_t i = 0; i < num_rows; i++)
     {
-        answer += cost[elem.first][elem.second];
+        distribution_plan[i] = assignment[i];
+        answer += cost[i][assignment[i]];
     }
     return answer;
 }
@@ -235,238 +222,6 @@ void COI_3_1<T>::Step_0()
 }
 
 
-template<typename T>
-bool COI_3_1<T>::Step_1_2()
-{
-#ifdef DEBUG
-    std::cout << "Step_1_2: " << "\n\n";
-
-    std::cout << "Matrix: " << std::endl;
-
-    printMatrix(D);
-
-    std::cout << "Plan: " << std::endl;
-
-    for(auto& el : distribution_plan)
-    {
-        std::cout << "row: " << el.first << " col: " << el.second << std::endl << std::endl;
-    }
-#endif
-
-    std::vector<std::pair<T, std::pair<std::size_t, std::size_t>>> swap_pairs;
-    std::set<std::size_t> prohibited_rows;
-
-    for(auto& first_value : distribution_plan)
-    {
-        T delta = T(0);
-        std::size_t row_fi = first_value.first;
-        std::size_t col_fi = first_value.second;
-
-        for(auto& second_value : distribution_plan)
-        {
-            std::size_t row_se = second_value.first;
-            std::size_t col_se = second_value.second;
-
-            if(row_se > row_fi)
-            {
-                delta = D[row_fi][col_fi] + D[row_se][col_se] - D[row_fi][col_se] - D[row_se][col_fi];
-
-                if(delta > 0)
-                    swap_pairs.push_back({delta, {row_fi, row_se}});
-            }
-        }
-    }
-
-    if(!swap_pairs.size())
-        return false;
-
-    std::sort(swap_pairs.begin(), swap_pairs.end(),
-              [](const auto& a, const auto& b) {
-        return a.first > b.first;
-    });
-
-#ifdef DEBUG
-
-    for(auto& pair : swap_pairs)
-    {
-        std::cout << "row1: " << pair.second.first << " col1: " << distribution_plan[pair.second.first] << std::endl;
-        std::cout << "row2: " << pair.second.second << " col2: " << distribution_plan[pair.second.second] << std::endl;
-        std::cout << "delta: " << pair.first << "\n";
-    }
-    std::cout << std::endl;
-#endif
-
-    for(auto& swap_pair : swap_pairs)
-    {
-        std::size_t row1 = swap_pair.second.first;
-        std::size_t row2 = swap_pair.second.second;
-
-        if(!prohibited_rows.count(row1) && !prohibited_rows.count(row2))
-        {
-            T col = distribution_plan[row1];
-
-            distribution_plan[row1] = distribution_plan[row2];
-            distribution_plan[row2] = col;
-
-            prohibited_rows.insert(row1);
-            prohibited_rows.insert(row2);
-        }
-    }
-
-    return true;
-}
-
-
-template<typename T>
-bool COI_3_1<T>::Step_3_4()
-{
-
-#ifdef DEBUG
-    std::cout << "Step_3_4: " << "\n\n";
-
-    std::cout << "Matrix: " << std::endl;
-
-    printMatrix(D);
-
-    std::cout << "Plan: " << std::endl;
-
-    for(auto& el : distribution_plan)
-    {
-        std::cout << "row: " << el.first << " col: " << el.second << std::endl << std::endl;
-    }
-#endif
-
-    std::vector<std::pair<T, std::pair<std::size_t, std::size_t>>> swap_pairs;
-
-    for(auto& first_value : distribution_plan)
-    {
-        std::size_t row_fi = first_value.first;
-        std::size_t col_fi = first_value.second;
-
-        for(auto& second_value : distribution_plan)
-        {
-            std::size_t row_se = second_value.first;
-            std::size_t col_se = second_value.second;
-
-            if(row_se != row_fi)
-            {
-                T delta = D[row_fi][col_fi] + D[row_se][col_se] - D[row_fi][col_se];
-                if(delta > 0)
-                    swap_pairs.push_back({delta, {row_fi, row_se}});
-            }
-        }
-    }
-
-    if(!swap_pairs.size())
-        return false;
-
-    std::sort(swap_pairs.begin(), swap_pairs.end(),
-              [](const auto& a, const auto& b) {
-        return a.first > b.first;
-    });
-
-#ifdef DEBUG
-
-    for(auto& pair : swap_pairs)
-    {
-        std::cout << "row1: " << pair.second.first << " col1: " << distribution_plan[pair.second.first] << std::endl;
-        std::cout << "row2: " << pair.second.second << " col2: " << distribution_plan[pair.second.second] << std::endl;
-        std::cout << "delta: " << pair.first << "\n";
-    }
-    std::cout << std::endl;
-#endif
-
-#ifdef DEBUG
-    int k = 1;
-#endif
-
-    for(auto& swap_pair : swap_pairs)
-    {
-        std::map<std::size_t, std::size_t> new_distribution_plan = distribution_plan;
-        std::set<std::size_t> prohibited_robots;
-
-        T Y = 0.0;
-
-        std::size_t start_robot_row = swap_pair.second.first;
-        std::size_t cur_robot_row = swap_pair.second.second;
-        std::size_t cur_robot_col = distribution_plan[cur_robot_row];
-
-        Y += D[cur_robot_row][cur_robot_col] - D[start_robot_row][cur_robot_col];
-        new_distribution_plan[start_robot_row] = distribution_plan[cur_robot_row];
-        prohibited_robots.insert(cur_robot_row);
-
-#ifdef DEBUG
-        std::cout << "Iteration: " << k << "\n\n";
-
-        std::cout << "First elements: " << std::endl;
-        std::cout << "row: " << cur_robot_row << " col: " << cur_robot_col << std::endl;
-#endif
-
-        do {
-            std::pair<T, std::size_t> next_robot = {-INT_MAX, 0};
-
-            for(std::size_t i = 0; i < num_rows; ++i)
-            {
-                if(prohibited_robots.count(i) || i == cur_robot_row)
-                    continue;
-
-                std::size_t next_row = i;
-                std::size_t next_col = distribution_plan[i];
-
-                T delta = D[cur_robot_row][cur_robot_col] + D[next_row][next_col] - D[cur_robot_row][next_col];
-                if(delta > next_robot.first)
-                {
-                    next_robot = {delta, next_row};
-                }
-            }
-
-
-            new_distribution_plan[cur_robot_row] = distribution_plan[next_robot.second];
-            Y += next_robot.first - D[cur_robot_row][cur_robot_col];
-
-            cur_robot_row = next_robot.second;
-            cur_robot_col = distribution_plan[next_robot.second];
-
-#ifdef DEBUG
-            std::cout << "Delta: " << next_robot.first << std::endl;
-            std::cout << "New elements: " << std::endl;
-            std::cout << "row1: " << cur_robot_row << " row2: " << cur_robot_col << std::endl;
-#endif
-
-            prohibited_robots.insert(cur_robot_row);
-        }
-        while(start_robot_row != cur_robot_row);
-
-#ifdef DEBUG
-        std::cout << "Y: " << Y << "\n\n";
-#endif
-
-        if(Y >= 0)
-        {
-            if(!Y)
-            {
-                auto tmp_dist = distribution_plan;
-                distribution_plan = new_distribution_plan;
-                bool step = Step_1_2();
-                if(step) return true;
-                else {
-                    distribution_plan = tmp_dist;
-                }
-            }
-            else {
-                distribution_plan = new_distribution_plan;
-                return true;
-            }
-        }
-
-#ifdef DEBUG
-        k++;
-#endif
-    }
-    return false;
-}
-
-
 template<typename T>
 void COI_3_1<T>::printMatrix(const std::vector<std::vector<T>>& matrix) const
 {
@@ -15,6 +15,7 @@ public:
     explicit COI_3_7(std::size_t n, std::size_t m, std::vector<std::vector<T>>& D, std::vector<int>& N);
     void Update(std::size_t n, std::size_t m, std::vector<std::vector<T>>& D, std::vector<int>& N);
     [[nodiscard]] T Start();
+    [[nodiscard]] const std::vector<int>& Assignment() const noexcept { return assignment; }
 
 private:
     [[nodiscard]] bool isUsedRows() const noexcept;
@@ -35,6 +36,7 @@ private:
     std::vector<int> N_max;
     std::vector<bool> used_rows;
     std::vector<bool> used_cols;
+    std::vector<int> assignment;
 
     T answer = T(0);
 };
@@ -42,7 +44,7 @@ private:
 
 template<typename T>
 COI_3_7<T>::COI_3_7(std::size_t n, std::size_t m, std::vector<std::vector<T>>& D, std::vector<int>& N)
-    : num_rows(n), num_cols(m), D(D), N_max(N), used_rows(n, false), used_cols(m, false)
+    : num_rows(n), num_cols(m), D(D), N_max(N), used_rows(n, false), used_cols(m, false), assignment(n, -1)
 {
     if (D.size() != n || (n > 0 && D[0].size() != m) || N.size() != m)
     {
@@ -96,6 +98,7 @@ T COI_3_7<T>::Start()
             if(is_optimal)
             {
                 used_rows[i] = true;
+                assignment[i] = static_cast<int>(max_d.second);
 
                 if(--N_max[max_d.second] == 0)
                 {
@@ -124,6 +127,7 @@ void COI_3_7<T>::Update(std::size_t n, std::size_t m, std::vector<std::vector<T>
     N_max = N;
     used_rows.assign(n, false);
     used_cols.assign(m, false);
+    assignment.assign(n, -1);
     answer = T(0);
 }
 
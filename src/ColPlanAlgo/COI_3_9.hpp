@@ -8,6 +8,9 @@
 #include <array>
 #include <tuple>
 #include <cstddef>
+#include <queue>
+#include <limits>
+#include <algorithm>
 
 
 template <typename T>
@@ -18,6 +21,7 @@ public:
     explicit COI_3_9(std::size_t n, std::size_t m, std::vector<std::vector<T>>& D, std::vector<int>& N);
     void Update(std::size_t n, std::size_t m, std::vector<std::vector<T>>& D, std::vector<int>& N);
     [[nodiscard]] T Start();
+    [[nodiscard]] const std::vector<int>& Assignment() const noexcept { return assignment; }
 
 private:
     [[nodiscard]] bool isUsedRows() const noexcept;
@@ -25,6 +29,25 @@ private:
     template<typename F>
     [[nodiscard]]bool notNull(const std::vector<F>& v) const noexcept;
 
+    struct RegretEntry
+    {
+        T result;
+        T delta;
+        std::size_t row;
+        std::size_t version;
+
+        // Больший result, затем больший delta, затем меньший номер строки
+        bool operator<(const RegretEntry& other) const noexcept
+        {
+            if(result != other.result) return result < other.result;
+            if(delta != other.delta) return delta < other.delta;
+            return row > other.row;
+        }
+    };
+
+    void RecomputeTop2(std::size_t row);
+    void PushRow(std::priority_queue<RegretEntry>& heap, std::size_t row) const;
+
     void printMatrix(const std::vector<std::vector<T>>& matrix) const;
 
 private:
@@ -38,6 +61,14 @@ private:
     std::vector<int> N_max;
     std::vector<bool> used_rows;
     std::vector<bool> used_cols;
+    std::vector<int> assignment;
+
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    std::vector<std::pair<T, std::size_t>> first_max;
+    std::vector<std::pair<T, std::size_t>> second_max;
+    std::vector<std::size_t> version;
+    std::vector<std::vector<std::size_t>> watchers;
 
     T answer = T{};
 };
@@ -45,7 +76,7 @@ private:
 
 template<typename T>
 COI_3_9<T>::COI_3_9(std::size_t n, std::size_t m, std::vector<std::vector<T>>& D, std::vector<int>& N)
-    : num_rows(n), num_cols(m), D(D), N_max(N), used_rows(n, false), used_cols(m, false)
+    : num_rows(n), num_cols(m), D(D), N_max(N), used_rows(n, false), used_cols(m, false), assignment(n, -1)
 {
     if (D.size() != n || (n > 0 && D[0].size() != m) || N.size() != m)
     {
@@ -63,74 +94,103 @@ T COI_3_9<T>::Start()
             used_cols[i] = true;
     }
 
-    while(notNull(N_max) && !isUsedRows())
+    // Кэш двух лучших столбцов строки и очередь строк по убыванию "сожаления"
+    first_max.assign(num_rows, {T(0), npos});
+    second_max.assign(num_rows, {T(0), npos});
+    version.assign(num_rows, 0);
+    watchers.assign(num_cols, {});
+
+    std::priority_queue<RegretEntry> heap;
+
+    for(std::size_t i = 0; i < num_rows; i++)
+    {
+        if(used_rows[i]) continue;
+
+        RecomputeTop2(i);
+        PushRow(heap, i);
+    }
+
+    while(!heap.empty())
     {
-        std::vector<std::pair<T, std::size_t>> first_max(num_rows, {T(0), 0});
-        std::vector<std::pair<T, std::size_t>> second_max(num_rows, {T(0), 0});
+        RegretEntry top = heap.top();
+        heap.pop();
+
+        std::size_t row = top.row;
+        if(used_rows[row] || top.version != version[row])
+            continue;
+
+        std::size_t col = first_max[row].second;
+
+        used_rows[row] = true;
+        assignment[row] = static_cast<int>(col);
+        answer += first_max[row].first;
 
-        for(std::size_t i = 0; i < num_rows; i++)
+        if(--N_max[col] == 0)
         {
-            if(used_rows[i]) continue;
+            used_cols[col] = true;
 
-            for(std::size_t j = 0; j < num_cols; j++)
+            // Пересчитываем только строки, у которых закрытый столбец был первым или вторым
+            for(std::size_t i : watchers[col])
             {
-                if(D[i][j] > first_max[i].first && !used_cols[j])
-                {
-                    first_max[i].first = D[i][j];
-                    first_max[i].second = j;
-                }
-            }
+                if(used_rows[i]) continue;
+                if(first_max[i].second != col && second_max[i].second != col) continue;
 
-            for(std::size_t j = 0; j < num_cols; j++)
-            {
-                if(D[i][j] > second_max[i].first && !used_cols[j] && j != first_max[i].second)
-                {
-                    second_max[i].first = D[i][j];
-                    second_max[i].second = j;
-                }
+                RecomputeTop2(i);
+                PushRow(heap, i);
             }
+            watchers[col].clear();
         }
+    }
 
-        std::vector<T> result(num_rows, 0);
-        std::vector<T> delta(num_rows, 0);
-        std::pair<T, std::size_t> res = {T(0), 0};
+    return answer;
+}
 
-        for(std::size_t i = 0; i < num_rows; i++)
+
+template<typename T>
+void COI_3_9<T>::RecomputeTop2(std::size_t row)
+{
+    std::pair<T, std::size_t> first = {T(0), npos};
+    std::pair<T, std::size_t> second = {T(0), npos};
+
+    for(std::size_t j = 0; j < num_cols; j++)
+    {
+        if(used_cols[j]) continue;
+
+        if(D[row][j] > first.first)
         {
-            result[i] = 2 * first_max[i].first - second_max[i].first;
-            delta[i] = first_max[i].first - second_max[i].first;
+            second = first;
+            first = {D[row][j], j};
         }
-
-        for(std::size_t i = 0; i < num_rows; i++)
+        else if(D[row][j] > second.first)
         {
-            if(res.first < result[i])
-            {
-                res.first = result[i];
-                res.second = i;
-            }
-            else if(abs(res.first - result[i]) < eps)
-            {
-                if(delta[res.second] < delta[i])
-                {
-                    res.first = result[i];
-                    res.second = i;
-                }
-            }
+            second = {D[row][j], j};
         }
+    }
 
-        used_rows[res.second] = true;
+    first_max[row] = first;
+    second_max[row] = second;
+    ++version[row];
 
-        if(--N_max[first_max[res.second].second] == 0)
-        {
-            used_cols[first_max[res.second].second] = true;
-        }
+    if(first.second != npos)
+        watchers[first.second].push_back(row);
+    if(second.second != npos)
+        watchers[second.second].push_back(row);
+}
 
-        answer += first_max[res.second].first;
-    }
 
-    return answer;
+template<typename T>
+void COI_3_9<T>::PushRow(std::priority_queue<RegretEntry>& heap, std::size_t row) const
+{
+    // Строка без доступных столбцов ничего не добавляет к ответу
+    if(first_max[row].second == npos)
+        return;
+
+    T result = 2 * first_max[row].first - second_max[row].first;
+    T delta = first_max[row].first - second_max[row].first;
+    heap.push({result, delta, row, version[row]});
 }
 
+
 template<typename T>
 void COI_3_9<T>::Update(std::size_t n, std::size_t m, std::vector<std::vector<T> > &D, std::vector<int> &N)
 {
@@ -145,6 +205,7 @@ void COI_3_9<T>::Update(std::size_t n, std::size_t m, std::vector<std::vector<T>
     N_max = N;
     used_rows.assign(n, false);
     used_cols.assign(m, false);
+    assignment.assign(n, -1);
     answer = T(0);
 }
 
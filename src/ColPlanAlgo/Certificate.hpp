@@ -0,0 +1,328 @@
+#ifndef CERTIFICATE_HPP
+#define CERTIFICATE_HPP
+
+#include <iostream>
+#include <vector>
+#include <stdlib.h>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include "Parallel.hpp"
+
+// Результат проверки назначения
+template <typename T>
+struct CertificateReport
+{
+    T primal = T(0);                // Полезность проверяемого назначения
+    T upper_bound = T(0);           // Двойственная оценка сверху для оптимума
+    T gap = T(0);                   // upper_bound - primal, гарантированный разрыв до оптимума
+    double relative_gap = 0.0;      // gap / upper_bound
+    T max_violation = T(0);         // Наибольшее нарушение условия ε-дополняющей нежёсткости по строкам
+    std::size_t violating_rows = 0; // Строки, у которых нарушение больше epsilon
+    std::size_t slack_columns = 0;  // Столбцы с ценой > 0, но незаполненной ёмкостью
+    bool feasible = true;           // Назначение допустимо (индексы и ёмкости N_max)
+};
+
+
+// Сертификат оптимальности для назначения, полученного любым решателем.
+//
+// Двойственная задача к LP-релаксации (x_ij >= 0, sum_j x_ij <= 1, sum_i x_ij <= N_j):
+//     min sum_i u_i + sum_j N_j p_j,  u_i + p_j >= D_ij,  u, p >= 0.
+// Для любых цен p >= 0 лучшие u_i = max(0, max_j (D_ij - p_j)), поэтому любой вектор
+// цен даёт оценку UB >= оптимума, а UB - primal - гарантированный разрыв. Цены берутся
+// из аукциона (AuctionAlgo::Prices) или из DualAscent.
+//
+// Matrix - любой тип с доступом D[i][j]; матрица не копируется.
+template <typename T>
+class Certificate
+{
+public:
+    Certificate() noexcept = default;
+
+    void SetThreads(std::size_t count) noexcept { threads = count; }
+
+    // Оценка и проверка ε-CS назначения при заданных ценах, O(n*m)
+    template<typename Matrix>
+    [[nodiscard]] CertificateReport<T> Check(std::size_t n, std::size_t m, const Matrix& D, const std::vector<int>& N,
+                                             const std::vector<int>& assignment, const std::vector<T>& prices,
+                                             double epsilon = 0.0);
+
+    // Покоординатный спуск по ценам: p_j точно минимизирует UB при остальных ценах.
+    // prices - начальные цены (пустой вектор - нули), на выходе улучшенные. Каждый проход
+    // O(n*m) плюс пересчёт строк, у которых столбец j входил в два лучших. Возвращает UB
+    template<typename Matrix>
+    T DualAscent(std::size_t n, std::size_t m, const Matrix& D, const std::vector<int>& N,
+                 std::vector<T>& prices, std::size_t max_passes = 10, double tolerance = 1e-9);
+
+    [[nodiscard]] std::size_t Passes() const noexcept { return passes; }
+
+private:
+    template<typename Matrix>
+    void ScanRow(std::size_t i, const Matrix& D, const std::vector<int>& N, const std::vector<T>& prices);
+
+private:
+    std::size_t num_cols = 0;
+    std::size_t threads = 0;
+    std::size_t passes = 0;
+
+    // Два лучших значения D_ij - p_j по строке и их столбцы
+    std::vector<T> best_1;
+    std::vector<T> best_2;
+    std::vector<std::size_t> arg_1;
+    std::vector<std::size_t> arg_2;
+};
+
+
+template<typename T>
+template<typename Matrix>
+CertificateReport<T> Certificate<T>::Check(std::size_t n, std::size_t m, const Matrix& D, const std::vector<int>& N,
+                                           const std::vector<int>& assignment, const std::vector<T>& prices,
+                                           double epsilon)
+{
+    if (N.size() != m || prices.size() != m || assignment.size() != n)
+    {
+        throw std::invalid_argument("Invalid sizes of N, prices or assignment for Certificate");
+    }
+
+    CertificateReport<T> report;
+
+    // Допустимость назначения
+    std::vector<int> load(m, 0);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        int j = assignment[i];
+        if (j < 0)
+            continue;
+        if (static_cast<std::size_t>(j) >= m || ++load[j] > N[j])
+        {
+            report.feasible = false;
+            continue;
+        }
+        report.primal += D[i][j];
+    }
+
+    // Отрицательные цены в двойственной задаче недопустимы
+    std::vector<T> p(m);
+    for (std::size_t j = 0; j < m; ++j)
+        p[j] = std::max(prices[j], T(0));
+
+    const std::size_t blocks = ParallelBlockCount(n, 64, threads);
+    std::vector<T> sum_u(blocks, T(0));
+    std::vector<T> violation(blocks, T(0));
+    std::vector<std::size_t> violating(blocks, 0);
+
+    ParallelFor(0, n, [&](std::size_t begin, std::size_t end, std::size_t block) {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            T u = T(0);
+            for (std::size_t j = 0; j < m; ++j)
+            {
+                if (N[j] > 0)
+                    u = std::max(u, D[i][j] - p[j]);
+            }
+            sum_u[block] += u;
+
+            // ε-CS: назначенная строка почти лучшая по ценам, свободная - почти без прибыли
+            int j = assignment[i];
+            T profit = (j >= 0 && static_cast<std::size_t>(j) < m) ? D[i][j] - p[j] : T(0);
+            T gap_i = u - profit;
+
+            // Допуск на округление: цены аукциона накапливают ошибку порядка ulp(D)
+            violation[block] = std::max(violation[block], gap_i);
+            if (gap_i > epsilon + 1e-9 * std::max<double>(std::abs(u), 1.0))
+                violating[block]++;
+        }
+    }, 64, threads);
+
+    report.upper_bound = T(0);
+    for (std::size_t b = 0; b < blocks; ++b)
+    {
+        report.upper_bound += sum_u[b];
+        report.max_violation = std::max(report.max_violation, violation[b]);
+        report.violating_rows += violating[b];
+    }
+
+    for (std::size_t j = 0; j < m; ++j)
+    {
+        if (N[j] <= 0)
+            continue;
+
+        report.upper_bound += N[j] * p[j];
+        if (p[j] > epsilon && load[j] < N[j])
+            report.slack_columns++;
+    }
+
+    report.gap = report.upper_bound - report.primal;
+    if (report.upper_bound > T(0))
+        report.relative_gap = static_cast<double>(report.gap) / static_cast<double>(report.upper_bound);
+
+    return report;
+}
+
+
+template<typename T>
+template<typename Matrix>
+void Certificate<T>::ScanRow(std::size_t i, const Matrix& D, const std::vector<int>& N, const std::vector<T>& prices)
+{
+    T first = std::numeric_limits<T>::lowest();
+    T second = std::numeric_limits<T>::lowest();
+    std::size_t first_col = num_cols;
+    std::size_t second_col = num_cols;
+
+    for (std::size_t j = 0; j < num_cols; ++j)
+    {
+        if (N[j] <= 0)
+            continue;
+
+        T value = D[i][j] - prices[j];
+        if (value > first)
+        {
+            second = first;
+            second_col = first_col;
+            first = value;
+            first_col = j;
+        }
+        else if (value > second)
+        {
+            second = value;
+            second_col = j;
+        }
+    }
+
+    best_1[i] = first;
+    best_2[i] = second;
+    arg_1[i] = first_col;
+    arg_2[i] = second_col;
+}
+
+
+template<typename T>
+template<typename Matrix>
+T Certificate<T>::DualAscent(std::size_t n, std::size_t m, const Matrix& D, const std::vector<int>& N,
+                             std::vector<T>& prices, std::size_t max_passes, double tolerance)
+{
+    if (N.size() != m || (!prices.empty() && prices.size() != m))
+    {
+        throw std::invalid_argument("Invalid sizes of N or prices for Certificate");
+    }
+
+    num_cols = m;
+    passes = 0;
+
+    prices.resize(m, T(0));
+    for (std::size_t j = 0; j < m; ++j)
+        prices[j] = N[j] > 0 ? std::max(prices[j], T(0)) : T(0);
+
+    best_1.resize(n);
+    best_2.resize(n);
+    arg_1.resize(n);
+    arg_2.resize(n);
+
+    ParallelFor(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; ++i)
+            ScanRow(i, D, N, prices);
+    }, 64, threads);
+
+    auto upper_bound = [&]() {
+        T total = T(0);
+        for (std::size_t i = 0; i < n; ++i)
+            total += std::max(best_1[i], T(0));
+        for (std::size_t j = 0; j < m; ++j)
+        {
+            if (N[j] > 0)
+                total += N[j] * prices[j];
+        }
+        return total;
+    };
+
+    T bound = upper_bound();
+    std::vector<T> reduced(n);
+
+    while (passes < max_passes)
+    {
+        passes++;
+
+        for (std::size_t j = 0; j < m; ++j)
+        {
+            if (N[j] <= 0)
+                continue;
+
+            // При остальных ценах UB(p_j) = N_j p_j + sum_i max(b_i, D_ij - p_j), где
+            // b_i = max(0, лучшее по строке без столбца j). Функция выпуклая, наклон
+            // N_j - #{i : D_ij - b_i > p_j}, минимум - в N_j-м по величине D_ij - b_i
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                T other = arg_1[i] == j ? best_2[i] : best_1[i];
+                reduced[i] = D[i][j] - std::max(other, T(0));
+            }
+
+            T price = T(0);
+            std::size_t k = static_cast<std::size_t>(N[j]);
+            if (k <= n)
+            {
+                std::nth_element(reduced.begin(), reduced.begin() + (k - 1), reduced.end(), std::greater<T>());
+                price = std::max(reduced[k - 1], T(0));
+            }
+
+            if (price == prices[j])
+                continue;
+
+            prices[j] = price;
+
+            // Обновляем два лучших значения строк; полный пересчёт строки нужен только
+            // если значение столбца j, входившего в двойку лучших, стало меньше второго
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                T value = D[i][j] - price;
+
+                if (arg_1[i] == j)
+                {
+                    if (value >= best_2[i])
+                        best_1[i] = value;
+                    else
+                        ScanRow(i, D, N, prices);
+                }
+                else if (arg_2[i] == j)
+                {
+                    if (value > best_1[i])
+                    {
+                        best_2[i] = best_1[i];
+                        arg_2[i] = arg_1[i];
+                        best_1[i] = value;
+                        arg_1[i] = j;
+                    }
+                    else if (value >= best_2[i])
+                        best_2[i] = value;
+                    else
+                        ScanRow(i, D, N, prices);
+                }
+                else if (value > best_1[i])
+                {
+                    best_2[i] = best_1[i];
+                    arg_2[i] = arg_1[i];
+                    best_1[i] = value;
+                    arg_1[i] = j;
+                }
+                else if (value > best_2[i])
+                {
+                    best_2[i] = value;
+                    arg_2[i] = j;
+                }
+            }
+        }
+
+        T next = upper_bound();
+        bool converged = bound - next <= tolerance * std::max(std::abs(bound), T(1));
+        bound = std::min(bound, next);
+        if (converged)
+            break;
+    }
+
+    return bound;
+}
+
+
+#endif // CERTIFICATE_HPP
@@ -0,0 +1,135 @@
+#ifndef GLOBALGREEDY_HPP
+#define GLOBALGREEDY_HPP
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+#include <cstdint>
+
+#include "Parallel.hpp"
+#include "RadixSort.hpp"
+
+// Глобальный жадный алгоритм: все n*m рёбер сортируются по убыванию полезности,
+// ребро принимается, если строка ещё свободна и у столбца осталась ёмкость N_max.
+// Сортировка - параллельная поразрядная по float-ключам, O(n*m) на проход.
+template <typename T>
+class GlobalGreedy
+{
+public:
+    GlobalGreedy() noexcept = default;
+    explicit GlobalGreedy(std::size_t n, std::size_t m, std::vector<std::vector<T>>& D, std::vector<int>& N);
+    void Update(std::size_t n, std::size_t m, std::vector<std::vector<T>>& D, std::vector<int>& N);
+    [[nodiscard]] T Start();
+    [[nodiscard]] const std::vector<int>& Assignment() const noexcept { return assignment; }
+
+    void SetThreads(std::size_t count) noexcept { threads = count; }
+
+private:
+    std::size_t num_rows = 0;
+    std::size_t num_cols = 0;
+
+    std::size_t threads = 0;
+
+    std::vector<std::vector<T>> D;
+    std::vector<int> N_max;
+    std::vector<bool> used_rows;
+    std::vector<int> assignment;
+
+    T answer = T(0);
+};
+
+
+template<typename T>
+GlobalGreedy<T>::GlobalGreedy(std::size_t n, std::size_t m, std::vector<std::vector<T>>& D, std::vector<int>& N)
+    : num_rows(n), num_cols(m), D(D), N_max(N), used_rows(n, false), assignment(n, -1)
+{
+    if (D.size() != n || (n > 0 && D[0].size() != m) || N.size() != m)
+    {
+        throw std::invalid_argument("Invalid dimensions or sizes for D or N");
+    }
+}
+
+
+template<typename T>
+T GlobalGreedy<T>::Start()
+{
+    const std::size_t total = num_rows * num_cols;
+    if (total > std::numeric_limits<std::uint32_t>::max())
+    {
+        throw std::invalid_argument("GlobalGreedy supports at most 2^32 edges");
+    }
+
+    // Ключ - инвертированная полезность, чтобы сортировка по возрастанию дала убывание
+    std::vector<std::uint64_t> edges(total);
+
+    ParallelFor(0, num_rows, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const std::uint32_t base = static_cast<std::uint32_t>(i * num_cols);
+            for (std::size_t j = 0; j < num_cols; ++j)
+            {
+                std::uint32_t key = ~FloatToSortableKey(static_cast<float>(D[i][j]));
+                edges[base + j] = MakeRadixItem(key, base + static_cast<std::uint32_t>(j));
+            }
+        }
+    }, 64, threads);
+
+    ParallelRadixSort(edges, threads);
+
+    std::size_t rows_left = num_rows;
+    long long capacity_left = 0;
+    for (int cap : N_max)
+        capacity_left += std::max(cap, 0);
+
+    for (std::uint64_t edge : edges)
+    {
+        if (!rows_left || !capacity_left)
+            break;
+
+        std::uint32_t index = RadixItemPayload(edge);
+        std::size_t i = index / num_cols;
+        std::size_t j = index % num_cols;
+
+        // Рёбра отсортированы, дальше только неположительные полезности
+        if (!(D[i][j] > T(0)))
+            break;
+
+        if (used_rows[i] || N_max[j] <= 0)
+            continue;
+
+        used_rows[i] = true;
+        assignment[i] = static_cast<int>(j);
+        N_max[j]--;
+        answer += D[i][j];
+
+        rows_left--;
+        capacity_left--;
+    }
+
+    return answer;
+}
+
+
+template<typename T>
+void GlobalGreedy<T>::Update(std::size_t n, std::size_t m, std::vector<std::vector<T> > &D, std::vector<int> &N)
+{
+    if (D.size() != n || (n > 0 && D[0].size() != m) || N.size() != m)
+    {
+        throw std::invalid_argument("Invalid dimensions or sizes for D or N in Update");
+    }
+
+    num_rows = n;
+    num_cols = m;
+    this->D = D;
+    N_max = N;
+    used_rows.assign(n, false);
+    assignment.assign(n, -1);
+    answer = T(0);
+}
+
+
+#endif // GLOBALGREEDY_HPP
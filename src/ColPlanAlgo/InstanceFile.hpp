@@ -0,0 +1,386 @@
+#ifndef INSTANCEFILE_HPP
+#define INSTANCEFILE_HPP
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// Бинарный формат экземпляра задачи о назначениях (little-endian, версия 1):
+//
+//     InstanceHeader                           - 96 байт
+//     capacities    int32[m]                   - N_j
+//     coordinates   double[2n + 2m], если есть - x роботов, y роботов, x задач, y задач
+//     matrix        dtype[n * row_stride]      - D по строкам, с выравниванием 64 байта
+//
+// Каждая секция начинается с границы 64 байт, длина строки матрицы row_stride
+// дополнена до 64 байт, поэтому каждая строка выровнена для SIMD. Смещения секций
+// записаны в заголовке - читатель не вычисляет их сам, и новые секции можно
+// добавлять, не ломая старых читателей.
+enum class InstanceDType : std::uint32_t
+{
+    Float64 = 0,
+    Float32 = 1
+};
+
+enum InstanceFlags : std::uint32_t
+{
+    InstanceHasCoordinates = 1u << 0
+};
+
+struct InstanceHeader
+{
+    char magic[8];                   // "CPAINST\0"
+    std::uint32_t version;
+    std::uint32_t header_size;
+    std::uint32_t dtype;             // InstanceDType
+    std::uint32_t flags;             // InstanceFlags
+    std::uint64_t n;
+    std::uint64_t m;
+    std::uint64_t row_stride;        // в элементах
+    std::uint64_t capacities_offset;
+    std::uint64_t coordinates_offset; // 0, если координат нет
+    std::uint64_t matrix_offset;
+    std::uint64_t file_size;
+    std::uint64_t reserved[2];
+};
+
+static_assert(sizeof(InstanceHeader) == 96, "InstanceHeader layout must not change within a version");
+
+inline constexpr char instance_magic[8] = {'C', 'P', 'A', 'I', 'N', 'S', 'T', '\0'};
+inline constexpr std::uint32_t instance_version = 1;
+inline constexpr std::uint64_t instance_alignment = 64;
+
+template<typename T>
+constexpr InstanceDType InstanceDTypeOf()
+{
+    static_assert(std::is_same_v<T, double> || std::is_same_v<T, float>, "Instance matrix must be double or float");
+    return std::is_same_v<T, double> ? InstanceDType::Float64 : InstanceDType::Float32;
+}
+
+inline std::uint64_t InstanceAlign(std::uint64_t value) noexcept
+{
+    return (value + instance_alignment - 1) / instance_alignment * instance_alignment;
+}
+
+
+// Матрица без владения памятью: строка i начинается с data + i * stride.
+// D[i][j] работает так же, как у std::vector<std::vector<T>>, поэтому вид можно
+// передавать решателям, принимающим Matrix шаблоном (LPAssignmentModel::Solve,
+// Certificate, LocalImprovement)
+template<typename T>
+class MatrixView
+{
+public:
+    MatrixView() noexcept = default;
+    MatrixView(const T* data, std::size_t rows, std::size_t cols, std::size_t stride) noexcept
+        : data(data), n(rows), m(cols), stride(stride)
+    {
+    }
+
+    [[nodiscard]] const T* operator[](std::size_t i) const noexcept { return data + i * stride; }
+    [[nodiscard]] const T* Row(std::size_t i) const noexcept { return data + i * stride; }
+
+    [[nodiscard]] std::size_t Rows() const noexcept { return n; }
+    [[nodiscard]] std::size_t Cols() const noexcept { return m; }
+    [[nodiscard]] std::size_t Stride() const noexcept { return stride; }
+
+    // Копия в формате, который принимают Update(n, m, D, N) решателей
+    [[nodiscard]] std::vector<std::vector<T>> ToNested() const
+    {
+        std::vector<std::vector<T>> D(n);
+        for (std::size_t i = 0; i < n; ++i)
+            D[i].assign(Row(i), Row(i) + m);
+        return D;
+    }
+
+private:
+    const T* data = nullptr;
+    std::size_t n = 0;
+    std::size_t m = 0;
+    std::size_t stride = 0;
+};
+
+
+// Запись экземпляра. Matrix - любой тип с доступом D[i][j]; coordinates -
+// 2n + 2m чисел в порядке секции координат или nullptr
+template<typename T, typename Matrix>
+void WriteInstance(const std::string& path, std::size_t n, std::size_t m, const Matrix& D,
+                   const std::vector<int>& N, const double* coordinates = nullptr)
+{
+    if (N.size() != m)
+    {
+        throw std::invalid_argument("WriteInstance: capacities size must equal m");
+    }
+
+    InstanceHeader header{};
+    std::memcpy(header.magic, instance_magic, sizeof(instance_magic));
+    header.version = instance_version;
+    header.header_size = sizeof(InstanceHeader);
+    header.dtype = static_cast<std::uint32_t>(InstanceDTypeOf<T>());
+    header.flags = coordinates ? InstanceHasCoordinates : 0;
+    header.n = n;
+    header.m = m;
+    header.row_stride = InstanceAlign(m * sizeof(T)) / sizeof(T);
+
+    header.capacities_offset = InstanceAlign(sizeof(InstanceHeader));
+    std::uint64_t end = header.capacities_offset + m * sizeof(std::int32_t);
+    if (coordinates)
+    {
+        header.coordinates_offset = InstanceAlign(end);
+        end = header.coordinates_offset + 2 * (n + m) * sizeof(double);
+    }
+    header.matrix_offset = InstanceAlign(end);
+    header.file_size = header.matrix_offset + n * header.row_stride * sizeof(T);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        throw std::runtime_error("WriteInstance: cannot open " + path);
+    }
+
+    std::uint64_t position = 0;
+    auto write = [&](const void* data, std::uint64_t size) {
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        position += size;
+    };
+    auto pad_to = [&](std::uint64_t offset) {
+        static const char zeros[instance_alignment] = {};
+        while (position < offset)
+            write(zeros, std::min<std::uint64_t>(offset - position, instance_alignment));
+    };
+
+    write(&header, sizeof(header));
+
+    pad_to(header.capacities_offset);
+    std::vector<std::int32_t> capacities(N.begin(), N.end());
+    write(capacities.data(), m * sizeof(std::int32_t));
+
+    if (coordinates)
+    {
+        pad_to(header.coordinates_offset);
+        write(coordinates, 2 * (n + m) * sizeof(double));
+    }
+
+    pad_to(header.matrix_offset);
+    std::vector<T> row(header.row_stride, T(0));
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        for (std::size_t j = 0; j < m; ++j)
+            row[j] = static_cast<T>(D[i][j]);
+        write(row.data(), header.row_stride * sizeof(T));
+    }
+
+    if (!out)
+    {
+        throw std::runtime_error("WriteInstance: write failed for " + path);
+    }
+}
+
+
+// Экземпляр, отображённый в память. Файл не читается целиком: страницы
+// подгружаются ОС при первом обращении решателя, поэтому открытие занимает
+// миллисекунды при любом размере. Объект владеет отображением - виды из
+// Matrix() действительны, пока он жив.
+class MappedInstance
+{
+public:
+    explicit MappedInstance(const std::string& path)
+    {
+        Map(path);
+        try
+        {
+            Validate(path);
+        }
+        catch (...)
+        {
+            Unmap();
+            throw;
+        }
+    }
+
+    ~MappedInstance() { Unmap(); }
+
+    MappedInstance(const MappedInstance&) = delete;
+    MappedInstance& operator=(const MappedInstance&) = delete;
+
+    [[nodiscard]] std::size_t Rows() const noexcept { return header.n; }
+    [[nodiscard]] std::size_t Cols() const noexcept { return header.m; }
+    [[nodiscard]] InstanceDType DType() const noexcept { return static_cast<InstanceDType>(header.dtype); }
+    [[nodiscard]] std::size_t FileSize() const noexcept { return header.file_size; }
+
+    template<typename T>
+    [[nodiscard]] MatrixView<T> Matrix() const
+    {
+        if (DType() != InstanceDTypeOf<T>())
+        {
+            throw std::runtime_error("MappedInstance: matrix dtype does not match the requested type");
+        }
+        return MatrixView<T>(reinterpret_cast<const T*>(base + header.matrix_offset),
+                             header.n, header.m, header.row_stride);
+    }
+
+    [[nodiscard]] std::vector<int> Capacities() const
+    {
+        const auto* capacities = reinterpret_cast<const std::int32_t*>(base + header.capacities_offset);
+        return std::vector<int>(capacities, capacities + header.m);
+    }
+
+    [[nodiscard]] bool HasCoordinates() const noexcept { return header.flags & InstanceHasCoordinates; }
+
+    // x роботов, y роботов, x задач, y задач; nullptr, если координат нет
+    [[nodiscard]] const double* RobotX() const noexcept { return Coordinates(0); }
+    [[nodiscard]] const double* RobotY() const noexcept { return Coordinates(header.n); }
+    [[nodiscard]] const double* TaskX() const noexcept { return Coordinates(2 * header.n); }
+    [[nodiscard]] const double* TaskY() const noexcept { return Coordinates(2 * header.n + header.m); }
+
+private:
+    const double* Coordinates(std::uint64_t offset) const noexcept
+    {
+        return HasCoordinates() ? reinterpret_cast<const double*>(base + header.coordinates_offset) + offset : nullptr;
+    }
+
+    void Map(const std::string& path)
+    {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("MappedInstance: cannot open " + path);
+        }
+
+        LARGE_INTEGER file_size;
+        GetFileSizeEx(file, &file_size);
+        size = static_cast<std::size_t>(file_size.QuadPart);
+
+        mapping = size ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+        void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view)
+        {
+            Unmap();
+            throw std::runtime_error("MappedInstance: cannot map " + path);
+        }
+        base = static_cast<const unsigned char*>(view);
+#else
+        fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::runtime_error("MappedInstance: cannot open " + path);
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0)
+        {
+            Unmap();
+            throw std::runtime_error("MappedInstance: cannot stat " + path);
+        }
+        size = static_cast<std::size_t>(st.st_size);
+
+        void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED)
+        {
+            Unmap();
+            throw std::runtime_error("MappedInstance: cannot map " + path);
+        }
+        base = static_cast<const unsigned char*>(view);
+#endif
+    }
+
+    void Unmap() noexcept
+    {
+#ifdef _WIN32
+        if (base)
+            UnmapViewOfFile(base);
+        if (mapping)
+            CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (base)
+            munmap(const_cast<unsigned char*>(base), size);
+        if (fd >= 0)
+            close(fd);
+        fd = -1;
+#endif
+        base = nullptr;
+    }
+
+    // Заголовок проверяется целиком до первого обращения к данным: повреждённый
+    // или обрезанный файл даёт исключение, а не чтение за концом отображения
+    void Validate(const std::string& path)
+    {
+        auto fail = [&](const char* reason) {
+            throw std::runtime_error("MappedInstance: " + path + ": " + reason);
+        };
+
+        if (size < sizeof(InstanceHeader))
+            fail("file is shorter than the header");
+
+        std::memcpy(&header, base, sizeof(InstanceHeader));
+
+        if (std::memcmp(header.magic, instance_magic, sizeof(instance_magic)) != 0)
+            fail("bad magic");
+        if (header.version != instance_version)
+            fail("unsupported version");
+        if (header.header_size < sizeof(InstanceHeader))
+            fail("bad header size");
+        if (header.file_size != size)
+            fail("file size does not match the header");
+
+        std::size_t element_size = 0;
+        switch (static_cast<InstanceDType>(header.dtype))
+        {
+        case InstanceDType::Float64: element_size = sizeof(double); break;
+        case InstanceDType::Float32: element_size = sizeof(float); break;
+        default: fail("unknown dtype");
+        }
+
+        const std::uint64_t limit = std::numeric_limits<std::uint64_t>::max() / 16;
+        if (header.n > limit || header.m > limit || header.row_stride < header.m || header.row_stride > limit)
+            fail("bad shape");
+        if (header.n && header.row_stride > limit / header.n / element_size)
+            fail("matrix size overflows");
+
+        auto check_section = [&](std::uint64_t offset, std::uint64_t bytes) {
+            if (offset % instance_alignment != 0 || offset < header.header_size ||
+                offset > header.file_size || bytes > header.file_size - offset)
+                fail("section lies outside the file");
+        };
+
+        check_section(header.capacities_offset, header.m * sizeof(std::int32_t));
+        if (HasCoordinates())
+            check_section(header.coordinates_offset, 2 * (header.n + header.m) * sizeof(double));
+        check_section(header.matrix_offset, header.n * header.row_stride * element_size);
+    }
+
+private:
+    InstanceHeader header{};
+    const unsigned char* base = nullptr;
+    std::size_t size = 0;
+
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+#endif // INSTANCEFILE_HPP
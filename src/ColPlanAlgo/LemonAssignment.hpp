@@ -0,0 +1,269 @@
+#ifndef LEMONASSIGNMENT_HPP
+#define LEMONASSIGNMENT_HPP
+
+#include <iostream>
+#include <vector>
+#include <stdlib.h>
+#include <cmath>
+#include <chrono>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+#include <lemon/smart_graph.h>
+#include <lemon/network_simplex.h>
+#include <lemon/cost_scaling.h>
+
+// Точное решение задачи о назначениях как потока минимальной стоимости в LEMON.
+//
+// Граф (SmartDigraph): у каждого робота предложение 1, у стока спрос n;
+//     робот -> задача   - пропускная способность 1, стоимость -D_ij * scale,
+//     задача -> сток    - пропускная способность N_j,
+//     робот -> сток     - обход, робот может остаться без задачи.
+// Стоимости целочисленные: D масштабируется на scale и округляется, а ответ
+// считается по исходным D.
+//
+// Дуги робот -> задача создаются только для кандидатов: D_ij > 0 и, если задан
+// candidates_per_row = k, k лучших задач строки. При k >= n ответ остаётся точным:
+// остальные n - 1 роботов занимают не больше n - 1 задач, поэтому среди k лучших
+// у каждого робота всегда найдётся свободная.
+template <typename T>
+class LemonAssignment
+{
+public:
+    enum class Method
+    {
+        NetworkSimplex,
+        CostScaling
+    };
+
+    LemonAssignment() noexcept = default;
+    explicit LemonAssignment(std::size_t n, std::size_t m, std::vector<std::vector<T>>& D, std::vector<int>& N);
+    void Update(std::size_t n, std::size_t m, std::vector<std::vector<T>>& D, std::vector<int>& N);
+    [[nodiscard]] T Start();
+    [[nodiscard]] const std::vector<int>& Assignment() const noexcept { return assignment; }
+
+    void SetMethod(Method value) noexcept { method = value; }
+    void SetCandidatesPerRow(std::size_t count) noexcept { candidates_per_row = count; }
+    void SetScale(double value);
+
+    // Число дуг робот -> задача в последнем графе
+    [[nodiscard]] std::size_t NumEdges() const noexcept { return edges.size(); }
+
+    // Время последнего вызова Start, мкс: построение графа и сам решатель
+    [[nodiscard]] long long BuildTime() const noexcept { return build_time; }
+    [[nodiscard]] long long SolveTime() const noexcept { return solve_time; }
+
+private:
+    using Graph = lemon::SmartDigraph;
+    using Cost = long long;
+
+    void Build(Graph& graph, Graph::ArcMap<Cost>& capacity, Graph::ArcMap<Cost>& cost,
+               Graph::NodeMap<Cost>& supply);
+
+    template<typename Solver>
+    void Run(Solver& solver, Graph::ArcMap<Cost>& capacity, Graph::ArcMap<Cost>& cost,
+             Graph::NodeMap<Cost>& supply);
+
+private:
+    std::size_t num_rows = 0;
+    std::size_t num_cols = 0;
+
+    Method method = Method::NetworkSimplex;
+    std::size_t candidates_per_row = 0;
+    double scale = 1e6;
+
+    std::vector<std::vector<T>> D;
+    std::vector<int> N_max;
+    std::vector<int> assignment;
+
+    // Дуги робот -> задача добавляются первыми, поэтому id дуги - индекс в edges
+    std::vector<std::pair<int, int>> edges;
+
+    long long build_time = 0;
+    long long solve_time = 0;
+
+    T answer = T(0);
+};
+
+
+template<typename T>
+LemonAssignment<T>::LemonAssignment(std::size_t n, std::size_t m, std::vector<std::vector<T>>& D, std::vector<int>& N)
+    : num_rows(n), num_cols(m), D(D), N_max(N), assignment(n, -1)
+{
+    if (D.size() != n || (n > 0 && D[0].size() != m) || N.size() != m)
+    {
+        throw std::invalid_argument("Invalid dimensions or sizes for D or N");
+    }
+}
+
+
+template<typename T>
+void LemonAssignment<T>::SetScale(double value)
+{
+    if (!(value > 0.0))
+    {
+        throw std::invalid_argument("LemonAssignment scale must be positive");
+    }
+    scale = value;
+}
+
+
+template<typename T>
+void LemonAssignment<T>::Build(Graph& graph, Graph::ArcMap<Cost>& capacity, Graph::ArcMap<Cost>& cost,
+                               Graph::NodeMap<Cost>& supply)
+{
+    const std::size_t k = (candidates_per_row && candidates_per_row < num_cols) ? candidates_per_row : num_cols;
+
+    std::vector<Graph::Node> robots(num_rows);
+    std::vector<Graph::Node> tasks(num_cols);
+
+    // Кандидаты выбираются до построения графа, чтобы зарезервировать ровно нужное число дуг
+    edges.clear();
+    edges.reserve(num_rows * k);
+
+    std::vector<int> cols(num_cols);
+    for (std::size_t i = 0; i < num_rows; ++i)
+    {
+        const auto& row = D[i];
+        std::iota(cols.begin(), cols.end(), 0);
+
+        auto last = std::partition(cols.begin(), cols.end(), [&](int j) {
+            return row[j] > T(0) && N_max[j] > 0;
+        });
+
+        std::size_t count = last - cols.begin();
+        if (count > k)
+        {
+            std::nth_element(cols.begin(), cols.begin() + (k - 1), last, [&](int a, int b) {
+                return row[a] > row[b];
+            });
+            count = k;
+        }
+
+        std::sort(cols.begin(), cols.begin() + count);
+        for (std::size_t c = 0; c < count; ++c)
+            edges.push_back({static_cast<int>(i), cols[c]});
+    }
+
+    graph.reserveNode(static_cast<int>(num_rows + num_cols + 1));
+    graph.reserveArc(static_cast<int>(edges.size() + num_cols + num_rows));
+
+    for (auto& node : robots)
+        node = graph.addNode();
+    for (auto& node : tasks)
+        node = graph.addNode();
+    Graph::Node sink = graph.addNode();
+
+    for (const auto& [i, j] : edges)
+    {
+        Graph::Arc arc = graph.addArc(robots[i], tasks[j]);
+        capacity[arc] = 1;
+        cost[arc] = -static_cast<Cost>(std::llround(static_cast<double>(D[i][j]) * scale));
+    }
+
+    for (std::size_t j = 0; j < num_cols; ++j)
+    {
+        Graph::Arc arc = graph.addArc(tasks[j], sink);
+        capacity[arc] = std::max(N_max[j], 0);
+        cost[arc] = 0;
+    }
+
+    for (std::size_t i = 0; i < num_rows; ++i)
+    {
+        Graph::Arc arc = graph.addArc(robots[i], sink);
+        capacity[arc] = 1;
+        cost[arc] = 0;
+
+        supply[robots[i]] = 1;
+    }
+
+    for (std::size_t j = 0; j < num_cols; ++j)
+        supply[tasks[j]] = 0;
+    supply[sink] = -static_cast<Cost>(num_rows);
+}
+
+
+template<typename T>
+template<typename Solver>
+void LemonAssignment<T>::Run(Solver& solver, Graph::ArcMap<Cost>& capacity, Graph::ArcMap<Cost>& cost,
+                             Graph::NodeMap<Cost>& supply)
+{
+    solver.upperMap(capacity).costMap(cost).supplyMap(supply);
+
+    if (solver.run() != Solver::OPTIMAL)
+    {
+        throw std::runtime_error("LEMON failed to find an optimal flow");
+    }
+
+    // Дуги робот -> задача - первые edges.size() дуг графа
+    for (std::size_t e = 0; e < edges.size(); ++e)
+    {
+        if (solver.flow(Graph::arcFromId(static_cast<int>(e))) > 0)
+        {
+            const auto& [i, j] = edges[e];
+            assignment[i] = j;
+            answer += D[i][j];
+        }
+    }
+}
+
+
+template<typename T>
+T LemonAssignment<T>::Start()
+{
+    using namespace std::chrono;
+
+    if (num_rows == 0 || num_cols == 0)
+        return answer;
+
+    auto start_build = high_resolution_clock::now();
+
+    Graph graph;
+    Graph::ArcMap<Cost> capacity(graph);
+    Graph::ArcMap<Cost> cost(graph);
+    Graph::NodeMap<Cost> supply(graph);
+
+    Build(graph, capacity, cost, supply);
+
+    auto end_build = high_resolution_clock::now();
+
+    if (method == Method::NetworkSimplex)
+    {
+        lemon::NetworkSimplex<Graph, Cost, Cost> solver(graph);
+        Run(solver, capacity, cost, supply);
+    }
+    else
+    {
+        lemon::CostScaling<Graph, Cost, Cost> solver(graph);
+        Run(solver, capacity, cost, supply);
+    }
+
+    auto end_solve = high_resolution_clock::now();
+
+    build_time = duration_cast<microseconds>(end_build - start_build).count();
+    solve_time = duration_cast<microseconds>(end_solve - end_build).count();
+
+    return answer;
+}
+
+
+template<typename T>
+void LemonAssignment<T>::Update(std::size_t n, std::size_t m, std::vector<std::vector<T> > &D, std::vector<int> &N)
+{
+    if (D.size() != n || (n > 0 && D[0].size() != m) || N.size() != m)
+    {
+        throw std::invalid_argument("Invalid dimensions or sizes for D or N in Update");
+    }
+
+    num_rows = n;
+    num_cols = m;
+    this->D = D;
+    N_max = N;
+    assignment.assign(n, -1);
+    edges.clear();
+    answer = T(0);
+}
+
+
+#endif // LEMONASSIGNMENT_HPP
@@ -0,0 +1,369 @@
+#ifndef LOCALIMPROVEMENT_HPP
+#define LOCALIMPROVEMENT_HPP
+
+#include <iostream>
+#include <vector>
+#include <stdlib.h>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+// Локальный поиск поверх любого допустимого назначения (робот -> задача, -1 - не назначен).
+// Перестановки 2-swap и циклические цепочки перенесены из COI_3_1 и переписаны
+// для матрицы полезностей, поэтому улучшатель можно применять к ответам
+// AuctionAlgo, COI_3_7, COI_3_9 и т.д.
+//
+// Matrix - любой тип с доступом D[i][j] (vector<vector<T>>, MatrixView и т.п.).
+// budget ограничивает число вычисленных дельт, так что время работы не
+// превышает O(budget) независимо от того, сошёлся ли поиск.
+// move_to_free = false отключает перевод строк на свободные столбцы: остаются
+// только обмены и циклы, т.е. ровно окрестность исходного COI_3_1.
+
+template <typename T>
+class LocalImprovement
+{
+public:
+    static constexpr std::size_t unlimited = std::numeric_limits<std::size_t>::max();
+
+    LocalImprovement() noexcept = default;
+    explicit LocalImprovement(bool move_to_free) noexcept : move_to_free(move_to_free) {}
+
+    template<typename Matrix>
+    [[nodiscard]] T Start(std::size_t n, std::size_t m, const Matrix& D, std::vector<int>& assignment,
+                          std::size_t budget = unlimited, const std::vector<int>& N = {});
+
+    [[nodiscard]] std::size_t UsedBudget() const noexcept { return used_budget; }
+
+private:
+    template<typename Matrix>
+    bool MoveToFree(const Matrix& D, std::vector<int>& assignment);
+    template<typename Matrix>
+    bool TwoSwap(const Matrix& D, std::vector<int>& assignment);
+    template<typename Matrix>
+    bool Cyclic(const Matrix& D, std::vector<int>& assignment);
+
+    [[nodiscard]] bool Spend(std::size_t count = 1) noexcept;
+    void CollectRows(const std::vector<int>& assignment);
+
+private:
+
+    std::size_t num_rows = 0;
+    std::size_t num_cols = 0;
+
+    bool move_to_free = true;
+
+    std::size_t budget = unlimited;
+    std::size_t used_budget = 0;
+
+    T max_val = T(0);
+    T gain = T(0);
+
+    std::vector<int> capacity;
+    std::vector<int> load;
+    std::vector<std::size_t> rows;
+};
+
+
+template<typename T>
+template<typename Matrix>
+T LocalImprovement<T>::Start(std::size_t n, std::size_t m, const Matrix& D, std::vector<int>& assignment,
+                             std::size_t budget, const std::vector<int>& N)
+{
+    if (assignment.size() != n || (!N.empty() && N.size() != m))
+    {
+        throw std::invalid_argument("Invalid dimensions or sizes for assignment or N");
+    }
+
+    num_rows = n;
+    num_cols = m;
+    this->budget = budget;
+    used_budget = 0;
+    gain = T(0);
+
+    if (n == 0 || m == 0)
+        return gain;
+
+    capacity = N.empty() ? std::vector<int>(m, 1) : N;
+    load.assign(m, 0);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (assignment[i] >= 0)
+            load[assignment[i]]++;
+    }
+
+    // Сдвиг COI_3_1 (max_val - D) нужен только для отбора стартовых пар цепочек
+    max_val = D[0][0];
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        for (std::size_t j = 0; j < m; ++j)
+        {
+            if (D[i][j] > max_val)
+                max_val = D[i][j];
+        }
+    }
+
+    while (used_budget < this->budget)
+    {
+        if (move_to_free && MoveToFree(D, assignment))
+            continue;
+
+        if (TwoSwap(D, assignment))
+            continue;
+
+        bool cyclic = false;
+        while (Cyclic(D, assignment))
+            cyclic = true;
+
+        if (!cyclic)
+            break;
+    }
+
+    return gain;
+}
+
+
+template<typename T>
+bool LocalImprovement<T>::Spend(std::size_t count) noexcept
+{
+    if (budget - used_budget < count)
+    {
+        used_budget = budget;
+        return false;
+    }
+    used_budget += count;
+    return true;
+}
+
+
+template<typename T>
+void LocalImprovement<T>::CollectRows(const std::vector<int>& assignment)
+{
+    rows.clear();
+    for (std::size_t i = 0; i < num_rows; ++i)
+    {
+        if (assignment[i] >= 0)
+            rows.push_back(i);
+    }
+}
+
+
+// Перевод строки на свободный столбец (или назначение неназначенной строки)
+template<typename T>
+template<typename Matrix>
+bool LocalImprovement<T>::MoveToFree(const Matrix& D, std::vector<int>& assignment)
+{
+    std::vector<std::size_t> free_cols;
+    for (std::size_t j = 0; j < num_cols; ++j)
+    {
+        if (load[j] < capacity[j])
+            free_cols.push_back(j);
+    }
+
+    if (free_cols.empty())
+        return false;
+
+    bool improved = false;
+
+    for (std::size_t i = 0; i < num_rows; ++i)
+    {
+        if (!Spend(free_cols.size()))
+            return improved;
+
+        T current = assignment[i] >= 0 ? D[i][assignment[i]] : T(0);
+        T best_delta = T(0);
+        std::size_t best_col = num_cols;
+
+        for (std::size_t j : free_cols)
+        {
+            if (load[j] >= capacity[j])
+                continue;
+
+            T delta = D[i][j] - current;
+            if (delta > best_delta)
+            {
+                best_delta = delta;
+                best_col = j;
+            }
+        }
+
+        if (best_col == num_cols)
+            continue;
+
+        if (assignment[i] >= 0)
+            load[assignment[i]]--;
+
+        assignment[i] = static_cast<int>(best_col);
+        load[best_col]++;
+        gain += best_delta;
+        improved = true;
+    }
+
+    return improved;
+}
+
+
+// Аналог COI_3_1::Step_1_2: попарный обмен столбцами
+template<typename T>
+template<typename Matrix>
+bool LocalImprovement<T>::TwoSwap(const Matrix& D, std::vector<int>& assignment)
+{
+    CollectRows(assignment);
+
+    std::vector<std::pair<T, std::pair<std::size_t, std::size_t>>> swap_pairs;
+    std::vector<bool> prohibited_rows(num_rows, false);
+
+    for (std::size_t a = 0; a < rows.size(); ++a)
+    {
+        if (!Spend(rows.size() - a))
+            return false;
+
+        std::size_t row_fi = rows[a];
+        std::size_t col_fi = assignment[row_fi];
+
+        for (std::size_t b = a + 1; b < rows.size(); ++b)
+        {
+            std::size_t row_se = rows[b];
+            std::size_t col_se = assignment[row_se];
+
+            T delta = D[row_fi][col_se] + D[row_se][col_fi] - D[row_fi][col_fi] - D[row_se][col_se];
+
+            if (delta > 0)
+                swap_pairs.push_back({delta, {row_fi, row_se}});
+        }
+    }
+
+    if (!swap_pairs.size())
+        return false;
+
+    std::sort(swap_pairs.begin(), swap_pairs.end(),
+              [](const auto& a, const auto& b) {
+        return a.first > b.first;
+    });
+
+    for (auto& swap_pair : swap_pairs)
+    {
+        std::size_t row1 = swap_pair.second.first;
+        std::size_t row2 = swap_pair.second.second;
+
+        if (!prohibited_rows[row1] && !prohibited_rows[row2])
+        {
+            std::swap(assignment[row1], assignment[row2]);
+            gain += swap_pair.first;
+
+            prohibited_rows[row1] = true;
+            prohibited_rows[row2] = true;
+        }
+    }
+
+    return true;
+}
+
+
+// Аналог COI_3_1::Step_3_4: циклическое переназначение по жадной цепочке
+template<typename T>
+template<typename Matrix>
+bool LocalImprovement<T>::Cyclic(const Matrix& D, std::vector<int>& assignment)
+{
+    CollectRows(assignment);
+
+    std::vector<std::pair<T, std::pair<std::size_t, std::size_t>>> swap_pairs;
+
+    for (std::size_t row_fi : rows)
+    {
+        if (!Spend(rows.size()))
+            return false;
+
+        std::size_t col_fi = assignment[row_fi];
+
+        for (std::size_t row_se : rows)
+        {
+            if (row_se == row_fi)
+                continue;
+
+            std::size_t col_se = assignment[row_se];
+
+            T delta = max_val - D[row_fi][col_fi] - D[row_se][col_se] + D[row_fi][col_se];
+            if (delta > 0)
+                swap_pairs.push_back({delta, {row_fi, row_se}});
+        }
+    }
+
+    if (!swap_pairs.size())
+        return false;
+
+    std::sort(swap_pairs.begin(), swap_pairs.end(),
+              [](const auto& a, const auto& b) {
+        return a.first > b.first;
+    });
+
+    std::vector<bool> prohibited_robots(num_rows);
+
+    for (auto& swap_pair : swap_pairs)
+    {
+        std::vector<int> new_assignment = assignment;
+        std::fill(prohibited_robots.begin(), prohibited_robots.end(), false);
+
+        std::size_t start_robot_row = swap_pair.second.first;
+        std::size_t cur_robot_row = swap_pair.second.second;
+        std::size_t cur_robot_col = assignment[cur_robot_row];
+
+        T Y = D[start_robot_row][cur_robot_col] - D[cur_robot_row][cur_robot_col];
+        new_assignment[start_robot_row] = assignment[cur_robot_row];
+        prohibited_robots[cur_robot_row] = true;
+
+        do {
+            if (!Spend(rows.size()))
+                return false;
+
+            std::pair<T, std::size_t> next_robot = {std::numeric_limits<T>::lowest(), start_robot_row};
+
+            for (std::size_t next_row : rows)
+            {
+                if (prohibited_robots[next_row] || next_row == cur_robot_row)
+                    continue;
+
+                std::size_t next_col = assignment[next_row];
+
+                T delta = D[cur_robot_row][next_col] - D[next_row][next_col];
+                if (delta > next_robot.first)
+                {
+                    next_robot = {delta, next_row};
+                }
+            }
+
+            new_assignment[cur_robot_row] = assignment[next_robot.second];
+            Y += next_robot.first;
+
+            cur_robot_row = next_robot.second;
+            cur_robot_col = assignment[next_robot.second];
+
+            prohibited_robots[cur_robot_row] = true;
+        }
+        while (start_robot_row != cur_robot_row);
+
+        if (Y >= 0)
+        {
+            if (!Y)
+            {
+                auto tmp_assignment = assignment;
+                T tmp_gain = gain;
+                assignment = new_assignment;
+                if (TwoSwap(D, assignment))
+                    return true;
+
+                assignment = tmp_assignment;
+                gain = tmp_gain;
+            }
+            else
+            {
+                assignment = new_assignment;
+                gain += Y;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+#endif // LOCALIMPROVEMENT_HPP
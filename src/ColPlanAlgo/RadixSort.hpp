@@ -0,0 +1,91 @@
+#ifndef RADIXSORT_HPP
+#define RADIXSORT_HPP
+
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+#include "Parallel.hpp"
+
+// Ключ float, упорядоченный как беззнаковое целое: больший float -> больший ключ
+inline std::uint32_t FloatToSortableKey(float value) noexcept
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+// Запись для сортировки: старшие 32 бита - ключ, младшие - полезная нагрузка (индекс)
+inline std::uint64_t MakeRadixItem(std::uint32_t key, std::uint32_t payload) noexcept
+{
+    return (static_cast<std::uint64_t>(key) << 32) | payload;
+}
+
+inline std::uint32_t RadixItemPayload(std::uint64_t item) noexcept
+{
+    return static_cast<std::uint32_t>(item);
+}
+
+// Параллельная устойчивая LSD-сортировка по старшим 32 битам (4 прохода по 8 бит).
+// Каждый поток строит гистограмму своего блока, затем по префиксным суммам
+// (разряд, поток) раскладывает блок в буфер. Проходы, в которых все ключи
+// имеют одинаковый разряд, пропускаются.
+inline void ParallelRadixSort(std::vector<std::uint64_t>& items, std::size_t threads = 0)
+{
+    constexpr std::size_t radix = 256;
+    constexpr std::size_t min_chunk = 1 << 16;
+
+    const std::size_t size = items.size();
+    if (size < 2)
+        return;
+
+    const std::size_t blocks = ParallelBlockCount(size, min_chunk, threads);
+
+    std::vector<std::uint64_t> buffer(size);
+    std::vector<std::array<std::size_t, radix>> histogram(blocks);
+
+    for (unsigned shift = 32; shift < 64; shift += 8)
+    {
+        ParallelFor(0, size, [&](std::size_t begin, std::size_t end, std::size_t block) {
+            auto& local = histogram[block];
+            local.fill(0);
+            for (std::size_t k = begin; k < end; ++k)
+                local[(items[k] >> shift) & 0xFF]++;
+        }, min_chunk, blocks);
+
+        bool single_digit = false;
+        for (std::size_t digit = 0; digit < radix && !single_digit; ++digit)
+        {
+            std::size_t count = 0;
+            for (std::size_t block = 0; block < blocks; ++block)
+                count += histogram[block][digit];
+            single_digit = (count == size);
+        }
+        if (single_digit)
+            continue;
+
+        // Гистограммы превращаются в начальные позиции записи для каждого (разряд, блок)
+        std::size_t offset = 0;
+        for (std::size_t digit = 0; digit < radix; ++digit)
+        {
+            for (std::size_t block = 0; block < blocks; ++block)
+            {
+                std::size_t count = histogram[block][digit];
+                histogram[block][digit] = offset;
+                offset += count;
+            }
+        }
+
+        ParallelFor(0, size, [&](std::size_t begin, std::size_t end, std::size_t block) {
+            auto& position = histogram[block];
+            for (std::size_t k = begin; k < end; ++k)
+                buffer[position[(items[k] >> shift) & 0xFF]++] = items[k];
+        }, min_chunk, blocks);
+
+        items.swap(buffer);
+    }
+}
+
+#endif // RADIXSORT_HPP
@@ -0,0 +1,342 @@
+#ifndef SINKHORNALGO_HPP
+#define SINKHORNALGO_HPP
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include "Parallel.hpp"
+
+// Приближённое решение через энтропийную регуляризацию (алгоритм Синхорна).
+// Ищется план P_ij = exp((D_ij + f_i + g_j) / reg) с маргиналами по строкам и столбцам;
+// потенциалы f, g пересчитываются поочерёдно в лог-области, что устойчиво и при малом reg.
+// Затем план округляется до допустимого целочисленного назначения с учётом N_max.
+//
+// reg управляет компромиссом: меньше reg - ближе к оптимуму, но больше итераций.
+// Погрешность до округления не превышает reg * n * log(m).
+template <typename T>
+class SinkhornAlgo
+{
+public:
+    SinkhornAlgo() noexcept = default;
+    explicit SinkhornAlgo(std::size_t n, std::size_t m, std::vector<std::vector<T>>& D, std::vector<int>& N);
+    void Update(std::size_t n, std::size_t m, std::vector<std::vector<T>>& D, std::vector<int>& N);
+    void SetParameters(double regularization, std::size_t max_iterations = 500, double tolerance = 1e-3,
+                       std::size_t threads = 0);
+    [[nodiscard]] T Start();
+
+    [[nodiscard]] const std::vector<int>& Assignment() const noexcept { return assignment; }
+    [[nodiscard]] std::size_t Iterations() const noexcept { return iterations; }
+    [[nodiscard]] double MarginalError() const noexcept { return marginal_error; }
+
+private:
+    double UpdateRows();
+    void UpdateCols();
+    void Round();
+
+private:
+    std::size_t num_rows = 0;
+    std::size_t num_cols = 0;
+
+    double reg = 0.5;
+    std::size_t max_iterations = 500;
+    double tolerance = 1e-3;
+    std::size_t threads = 0;
+
+    std::vector<std::vector<T>> D;
+    std::vector<int> N_max;
+    std::vector<int> assignment;
+
+    // Потенциалы в единицах reg и логарифмы маргиналов
+    std::vector<double> f;
+    std::vector<double> g;
+    std::vector<double> log_a;
+    std::vector<double> log_b;
+    double total_mass = 0.0;
+
+    // Рабочие буферы итераций выделяются один раз в Start: по строке длины m
+    // на блок ParallelFor (x в UpdateRows, частичные max/суммы в UpdateCols)
+    std::size_t blocks = 0;
+    std::vector<std::vector<double>> block_buffers;
+    std::vector<double> block_errors;
+    std::vector<double> col_max;
+
+    std::size_t iterations = 0;
+    double marginal_error = 0.0;
+
+    T answer = T(0);
+};
+
+
+template<typename T>
+SinkhornAlgo<T>::SinkhornAlgo(std::size_t n, std::size_t m, std::vector<std::vector<T>>& D, std::vector<int>& N)
+    : num_rows(n), num_cols(m), D(D), N_max(N), assignment(n, -1)
+{
+    if (D.size() != n || (n > 0 && D[0].size() != m) || N.size() != m)
+    {
+        throw std::invalid_argument("Invalid dimensions or sizes for D or N");
+    }
+}
+
+
+template<typename T>
+void SinkhornAlgo<T>::SetParameters(double regularization, std::size_t max_iterations, double tolerance,
+                                    std::size_t threads)
+{
+    if (!(regularization > 0.0))
+    {
+        throw std::invalid_argument("Sinkhorn regularization must be positive");
+    }
+
+    reg = regularization;
+    this->max_iterations = max_iterations;
+    this->tolerance = tolerance;
+    this->threads = threads;
+}
+
+
+template<typename T>
+T SinkhornAlgo<T>::Start()
+{
+    long long capacity = 0;
+    for (int cap : N_max)
+        capacity += std::max(cap, 0);
+
+    if (num_rows == 0 || capacity == 0)
+        return answer;
+
+    // Масса плана - сколько пар вообще можно назначить; строки и столбцы делят её поровну
+    // и пропорционально N_max соответственно
+    total_mass = static_cast<double>(std::min<long long>(num_rows, capacity));
+
+    log_a.assign(num_rows, std::log(total_mass / num_rows));
+    log_b.assign(num_cols, -std::numeric_limits<double>::infinity());
+    for (std::size_t j = 0; j < num_cols; ++j)
+    {
+        if (N_max[j] > 0)
+            log_b[j] = std::log(total_mass * N_max[j] / capacity);
+    }
+
+    f.assign(num_rows, 0.0);
+    g.assign(num_cols, 0.0);
+    for (std::size_t j = 0; j < num_cols; ++j)
+    {
+        if (N_max[j] <= 0)
+            g[j] = -std::numeric_limits<double>::infinity();
+    }
+
+    blocks = ParallelBlockCount(num_rows, 16, threads);
+    block_buffers.assign(blocks, std::vector<double>(num_cols));
+    block_errors.assign(blocks, 0.0);
+    col_max.assign(num_cols, 0.0);
+
+    for (iterations = 0; iterations < max_iterations; ++iterations)
+    {
+        marginal_error = UpdateRows();
+        if (iterations > 0 && marginal_error < tolerance)
+            break;
+        UpdateCols();
+    }
+
+    Round();
+    return answer;
+}
+
+
+// f_i = log a_i - LSE_j(D_ij / reg + g_j); попутно считается невязка по строкам
+template<typename T>
+double SinkhornAlgo<T>::UpdateRows()
+{
+    const double inv_reg = 1.0 / reg;
+
+    ParallelFor(0, num_rows, [&](std::size_t begin, std::size_t end, std::size_t block) {
+        double* x = block_buffers[block].data();
+        const double* gp = g.data();
+        double error = 0.0;
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const T* row = D[i].data();
+
+            double mx = -std::numeric_limits<double>::infinity();
+            for (std::size_t j = 0; j < num_cols; ++j)
+            {
+                x[j] = row[j] * inv_reg + gp[j];
+                mx = std::max(mx, x[j]);
+            }
+
+            double sum = 0.0;
+            for (std::size_t j = 0; j < num_cols; ++j)
+                sum += std::exp(x[j] - mx);
+
+            double lse = mx + std::log(sum);
+            error += std::abs(std::exp(f[i] + lse) - std::exp(log_a[i]));
+            f[i] = log_a[i] - lse;
+        }
+        block_errors[block] = error;
+    }, 16, threads);
+
+    return std::accumulate(block_errors.begin(), block_errors.end(), 0.0) / total_mass;
+}
+
+
+// g_j = log b_j - LSE_i(D_ij / reg + f_i). Матрица хранится по строкам, поэтому каждый
+// блок строк копит свои максимумы и суммы по всем столбцам, а затем они сводятся
+template<typename T>
+void SinkhornAlgo<T>::UpdateCols()
+{
+    const double inv_reg = 1.0 / reg;
+    const double neg_inf = -std::numeric_limits<double>::infinity();
+
+    ParallelFor(0, num_rows, [&](std::size_t begin, std::size_t end, std::size_t block) {
+        double* mx = block_buffers[block].data();
+        std::fill(mx, mx + num_cols, neg_inf);
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const T* row = D[i].data();
+            const double fi = f[i];
+            for (std::size_t j = 0; j < num_cols; ++j)
+                mx[j] = std::max(mx[j], row[j] * inv_reg + fi);
+        }
+    }, 16, threads);
+
+    std::fill(col_max.begin(), col_max.end(), neg_inf);
+    for (std::size_t b = 0; b < blocks; ++b)
+    {
+        for (std::size_t j = 0; j < num_cols; ++j)
+            col_max[j] = std::max(col_max[j], block_buffers[b][j]);
+    }
+
+    ParallelFor(0, num_rows, [&](std::size_t begin, std::size_t end, std::size_t block) {
+        double* sum = block_buffers[block].data();
+        std::fill(sum, sum + num_cols, 0.0);
+        const double* cm = col_max.data();
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const T* row = D[i].data();
+            const double fi = f[i];
+            for (std::size_t j = 0; j < num_cols; ++j)
+                sum[j] += std::exp(row[j] * inv_reg + fi - cm[j]);
+        }
+    }, 16, threads);
+
+    for (std::size_t j = 0; j < num_cols; ++j)
+    {
+        if (N_max[j] <= 0)
+            continue;
+
+        double sum = 0.0;
+        for (std::size_t b = 0; b < blocks; ++b)
+            sum += block_buffers[b][j];
+
+        g[j] = log_b[j] - (col_max[j] + std::log(sum));
+    }
+}
+
+
+// Округление: каждая строка хочет столбец с наибольшим P_ij. Строки обрабатываются
+// по убыванию уверенности (P_ij); если ёмкость столбца исчерпана, строка берёт лучший
+// по D_ij / reg + g_j столбец среди оставшихся
+template<typename T>
+void SinkhornAlgo<T>::Round()
+{
+    const double inv_reg = 1.0 / reg;
+
+    std::vector<std::size_t> best_col(num_rows, 0);
+    std::vector<double> confidence(num_rows, 0.0);
+
+    ParallelFor(0, num_rows, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            double best = -std::numeric_limits<double>::infinity();
+            for (std::size_t j = 0; j < num_cols; ++j)
+            {
+                double score = D[i][j] * inv_reg + g[j];
+                if (score > best)
+                {
+                    best = score;
+                    best_col[i] = j;
+                }
+            }
+            confidence[i] = best + f[i];
+        }
+    }, 16, threads);
+
+    std::vector<std::size_t> order(num_rows);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return confidence[a] > confidence[b];
+    });
+
+    std::vector<int> capacity = N_max;
+    std::vector<std::size_t> deferred;
+
+    for (std::size_t i : order)
+    {
+        std::size_t j = best_col[i];
+        if (capacity[j] > 0 && D[i][j] > T(0))
+        {
+            capacity[j]--;
+            assignment[i] = static_cast<int>(j);
+            answer += D[i][j];
+        }
+        else
+        {
+            deferred.push_back(i);
+        }
+    }
+
+    for (std::size_t i : deferred)
+    {
+        double best = -std::numeric_limits<double>::infinity();
+        std::size_t col = num_cols;
+
+        for (std::size_t j = 0; j < num_cols; ++j)
+        {
+            if (capacity[j] <= 0 || !(D[i][j] > T(0)))
+                continue;
+
+            double score = D[i][j] * inv_reg + g[j];
+            if (score > best)
+            {
+                best = score;
+                col = j;
+            }
+        }
+
+        if (col == num_cols)
+            continue;
+
+        capacity[col]--;
+        assignment[i] = static_cast<int>(col);
+        answer += D[i][col];
+    }
+}
+
+
+template<typename T>
+void SinkhornAlgo<T>::Update(std::size_t n, std::size_t m, std::vector<std::vector<T> > &D, std::vector<int> &N)
+{
+    if (D.size() != n || (n > 0 && D[0].size() != m) || N.size() != m)
+    {
+        throw std::invalid_argument("Invalid dimensions or sizes for D or N in Update");
+    }
+
+    num_rows = n;
+    num_cols = m;
+    this->D = D;
+    N_max = N;
+    assignment.assign(n, -1);
+    iterations = 0;
+    marginal_error = 0.0;
+    answer = T(0);
+}
+
+
+#endif // SINKHORNALGO_HPP
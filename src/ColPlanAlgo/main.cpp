@@ -11,6 +11,8 @@
 #include <chrono>
 #include <ranges>
 #include <algorithm>
+#include <optional>
+#include <string>
 
 #include "COI_3_7.hpp"
 #include "COI_3_9.hpp"
@@ -18,6 +20,12 @@
 #include "solving_LP.hpp"
 #include "HungarianAlgo.hpp"
 #include "AuctionAlgo.hpp"
+#include "LocalImprovement.hpp"
+#include "GlobalGreedy.hpp"
+#include "SinkhornAlgo.hpp"
+#include "Certificate.hpp"
+#include "LemonAssignment.hpp"
+#include "InstanceFile.hpp"
 
 #define LINEAR
 #define COI_3_1_def
@@ -31,6 +39,20 @@ int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
 
+    // --replay <file>  - один прогон на экземпляре из бинарного файла (InstanceFile.hpp)
+    // --dump <prefix>  - сохранять каждый случайный экземпляр в <prefix><n>.inst
+    std::string replay_path;
+    std::string dump_prefix;
+    for (int a = 1; a + 1 < argc; ++a)
+    {
+        std::string arg = argv[a];
+        if (arg == "--replay")
+            replay_path = argv[++a];
+        else if (arg == "--dump")
+            dump_prefix = argv[++a];
+    }
+    const bool replay = !replay_path.empty();
+
     std::random_device rd;
     std::mt19937 gen(rd());
 
@@ -51,16 +73,22 @@ int main(int argc, char *argv[])
     std::vector<double> answers_3_7;
     std::vector<double> answers_3_9;
     std::vector<double> answers_Auction;
+    std::vector<double> answers_Greedy;
+    std::vector<double> answers_Sinkhorn;
 
 
     std::vector<long long> times_hunAlgo;
     std::vector<long long> times_lpAlgo;
+    std::vector<long long> times_NetworkSimplex;
+    std::vector<long long> times_CostScaling;
 #ifdef COI_3_1_def
     std::vector<long long> times_3_1;  // Время выполнения COI_3_1
 #endif
     std::vector<long long> times_3_7;  // Время выполнения COI_3_7
     std::vector<long long> times_3_9;  // Время выполнения COI_3_9
     std::vector<long long> times_Auction;
+    std::vector<long long> times_Greedy;
+    std::vector<long long> times_Sinkhorn;
 
     std::vector<double> answer_diffs_1;  // Разница решений (answer_3_9 - answer_3_7)
 #ifdef COI_3_1_def
@@ -69,28 +97,84 @@ int main(int argc, char *argv[])
     std::vector<double> answer_diffs_3; // Разница решений (answer_LP - answer_3_9)
     std::vector<double> answer_diffs_4; // Разница решений (answer_LP - answer_3_1)
     std::vector<double> answer_diffs_5;
+    std::vector<double> answer_diffs_6; // Разница решений (answer_Hungarian - answer_Greedy)
+
+    // Модель GLPK переиспользуется между итерациями одного размера
+    LPAssignmentModel lpModel;
 
     //// ==================================================================
 
-    for(int iter = 2; iter < NUM_ITERATIONS; iter++)
+    // В режиме повтора - одна итерация на экземпляре из файла
+    const int first_iter = replay ? NUM_ITERATIONS - 1 : 2;
+
+    for(int iter = first_iter; iter < NUM_ITERATIONS; iter++)
     {
         int n = iter + 1;
         int m = n;
 
-        std::vector<std::vector<double>> D(n, std::vector<double>(m));
-        std::vector<int> N(m);
+        // view - матрица для решателей с шаблонным Matrix (LP, локальный поиск,
+        // сертификат): при повторе читается прямо из отображения файла, которое
+        // живёт до конца итерации. D - вложенная копия для решателей с Update(n, m, D, N)
+        // и vector<vector>-интерфейсом
+        MatrixView<double> view;
+        std::vector<std::vector<double>> D;
+        std::vector<int> N;
 
-        for (int i = 0; i < n; i++)
+        std::optional<MappedInstance> instance;
+        std::vector<double> generated;
+
+        if (replay)
         {
-            for (int j = 0; j < m; j++)
+            try
             {
-                D[i][j] = valueDist(gen);
+                auto start_Load = high_resolution_clock::now();
+
+                instance.emplace(replay_path);
+                n = static_cast<int>(instance->Rows());
+                m = static_cast<int>(instance->Cols());
+                N = instance->Capacities();
+                view = instance->Matrix<double>();
+
+                auto end_Load = high_resolution_clock::now();
+
+                D = view.ToNested();
+
+                auto end_Copy = high_resolution_clock::now();
+
+                std::cout << "Replay " << replay_path << ": " << n << " x " << m
+                          << ", " << instance->FileSize() << " bytes, map: "
+                          << duration_cast<microseconds>(end_Load - start_Load).count()
+                          << " microseconds, copy for Update: "
+                          << duration_cast<microseconds>(end_Copy - end_Load).count() << " microseconds" << std::endl;
+            }
+            catch (const std::exception& e)
+            {
+                std::cout << "Cannot load instance: " << e.what() << '\n';
+                exit(EXIT_FAILURE);
             }
         }
-
-        for (int i = 0; i < m; i++)
+        else
         {
-            N[i] = nDist(gen);
+            generated.resize(static_cast<std::size_t>(n) * m);
+            N.resize(m);
+
+            for (double& value : generated)
+            {
+                value = valueDist(gen);
+            }
+
+            for (int i = 0; i < m; i++)
+            {
+                N[i] = nDist(gen);
+            }
+
+            view = MatrixView<double>(generated.data(), n, m, m);
+            D = view.ToNested();
+
+            if (!dump_prefix.empty())
+            {
+                WriteInstance<double>(dump_prefix + std::to_string(n) + ".inst", n, m, D, N);
+            }
         }
 
         try
@@ -99,7 +183,8 @@ int main(int argc, char *argv[])
 
             auto start_LP = high_resolution_clock::now();
 
-            double answer_LP = solveAssignmentProblem_LP(D);
+            std::vector<int> assignment_LP;
+            double answer_LP = lpModel.Solve(n, m, view, N, assignment_LP);
 
             auto end_LP = high_resolution_clock::now();
             auto duration_LP = duration_cast<microseconds>(end_LP - start_LP);
@@ -117,6 +202,33 @@ int main(int argc, char *argv[])
 
             //// ==================================================================
 
+            // Поток минимальной стоимости в LEMON: полный граф и граф из k лучших задач строки
+            const std::size_t lemon_candidates = 8;
+
+            auto run_lemon = [&](LemonAssignment<double>::Method method, std::size_t candidates) {
+                auto start_Lemon = high_resolution_clock::now();
+
+                LemonAssignment<double> lemonAlgo;
+                lemonAlgo.Update(n, m, D, N);
+                lemonAlgo.SetMethod(method);
+                lemonAlgo.SetCandidatesPerRow(candidates);
+                double answer = lemonAlgo.Start();
+
+                auto end_Lemon = high_resolution_clock::now();
+                return std::make_tuple(answer, duration_cast<microseconds>(end_Lemon - start_Lemon), lemonAlgo.NumEdges());
+            };
+
+            auto [answer_NetworkSimplex, duration_NetworkSimplex, edges_NetworkSimplex] =
+                run_lemon(LemonAssignment<double>::Method::NetworkSimplex, 0);
+            auto [answer_CostScaling, duration_CostScaling, edges_CostScaling] =
+                run_lemon(LemonAssignment<double>::Method::CostScaling, 0);
+            auto [answer_NetworkSimplex_k, duration_NetworkSimplex_k, edges_NetworkSimplex_k] =
+                run_lemon(LemonAssignment<double>::Method::NetworkSimplex, lemon_candidates);
+            auto [answer_CostScaling_k, duration_CostScaling_k, edges_CostScaling_k] =
+                run_lemon(LemonAssignment<double>::Method::CostScaling, lemon_candidates);
+
+            //// ==================================================================
+
 #ifdef COI_3_1_def
             auto start_3_1 = high_resolution_clock::now();
 
@@ -163,6 +275,67 @@ int main(int argc, char *argv[])
 
             //// ==================================================================
 
+            auto start_Greedy = high_resolution_clock::now();
+
+            GlobalGreedy<double> globalGreedy;
+            globalGreedy.Update(n, m, D, N);
+            double answer_Greedy = globalGreedy.Start();
+
+            auto end_Greedy = high_resolution_clock::now();
+            auto duration_Greedy = duration_cast<microseconds>(end_Greedy - start_Greedy);
+
+            //// ==================================================================
+
+            auto start_Sinkhorn = high_resolution_clock::now();
+
+            SinkhornAlgo<double> sinkhornAlgo;
+            sinkhornAlgo.Update(n, m, D, N);
+            sinkhornAlgo.SetParameters(0.1);
+            double answer_Sinkhorn = sinkhornAlgo.Start();
+
+            auto end_Sinkhorn = high_resolution_clock::now();
+            auto duration_Sinkhorn = duration_cast<microseconds>(end_Sinkhorn - start_Sinkhorn);
+
+            //// ==================================================================
+
+            // Локальный поиск поверх эвристик с ограниченным бюджетом
+            const std::size_t ls_budget = 20 * static_cast<std::size_t>(n) * m;
+
+            auto polish = [&](std::vector<int> plan) {
+                auto start_LS = high_resolution_clock::now();
+
+                LocalImprovement<double> improver;
+                double gain = improver.Start(n, m, view, plan, ls_budget, N);
+
+                auto end_LS = high_resolution_clock::now();
+                return std::make_pair(gain, duration_cast<microseconds>(end_LS - start_LS));
+            };
+
+            auto [gain_LS_3_7, duration_LS_3_7] = polish(coi_3_7.Assignment());
+            auto [gain_LS_3_9, duration_LS_3_9] = polish(coi_3_9.Assignment());
+            auto [gain_LS_Auction, duration_LS_Auction] = polish(assigment);
+
+            //// ==================================================================
+
+            // Двойственная оценка: цены аукциона дают оценку для него самого, а покоординатный
+            // спуск от этих цен - общую оценку для всех эвристик без точного решения
+            auto start_Cert = high_resolution_clock::now();
+
+            Certificate<double> certificate;
+            auto cert_Auction = certificate.Check(n, m, view, N, assigment, auctionAlgo.Prices(), eps);
+
+            std::vector<double> dual_prices = auctionAlgo.Prices();
+            certificate.DualAscent(n, m, view, N, dual_prices);
+
+            auto cert_3_7 = certificate.Check(n, m, view, N, coi_3_7.Assignment(), dual_prices);
+            auto cert_3_9 = certificate.Check(n, m, view, N, coi_3_9.Assignment(), dual_prices);
+            auto cert_Greedy = certificate.Check(n, m, view, N, globalGreedy.Assignment(), dual_prices);
+
+            auto end_Cert = high_resolution_clock::now();
+            auto duration_Cert = duration_cast<microseconds>(end_Cert - start_Cert);
+
+            //// ==================================================================
+
             matrixSizes.push_back(n);
 
             answers_hunAlgo.push_back(answer_hunAlgo);
@@ -173,17 +346,23 @@ int main(int argc, char *argv[])
             answers_3_7.push_back(answer_3_7);
             answers_3_9.push_back(answer_3_9);
             answers_Auction.push_back(answer_Auction);
+            answers_Greedy.push_back(answer_Greedy);
+            answers_Sinkhorn.push_back(answer_Sinkhorn);
 
 
 
             times_hunAlgo.push_back(duration_hunAlgo.count());
             times_lpAlgo.push_back(duration_LP.count());
+            times_NetworkSimplex.push_back(duration_NetworkSimplex.count());
+            times_CostScaling.push_back(duration_CostScaling.count());
 #ifdef COI_3_1_def
             times_3_1.push_back(duration_3_1.count());
 #endif
             times_3_7.push_back(duration_3_7.count());
             times_3_9.push_back(duration_3_9.count());
             times_Auction.push_back(duration_Auction.count());
+            times_Greedy.push_back(duration_Greedy.count());
+            times_Sinkhorn.push_back(duration_Sinkhorn.count());
 
             answer_diffs_1.push_back(answer_3_9 - answer_3_7);
 #ifdef COI_3_1_def
@@ -192,19 +371,47 @@ int main(int argc, char *argv[])
             answer_diffs_3.push_back(answer_hunAlgo - answer_3_9);
             answer_diffs_4.push_back(answer_hunAlgo - answer_3_1);
             answer_diffs_5.push_back(answer_hunAlgo - answer_Auction);
+            answer_diffs_6.push_back(answer_hunAlgo - answer_Greedy);
 
             //// ==================================================================
 
             std::cout << "\nIteration " << iter + 1 << ":" << std::endl;
             std::cout << "Matrix size: " << n << " x " << m << std::endl;
-            std::cout << "LP_Answer: " << answer_LP <<  ", Time: " << duration_LP.count() << " microseconds" << std::endl;
+            std::cout << "LP_Answer: " << answer_LP <<  ", Time: " << duration_LP.count() << " microseconds"
+                      << " (build: " << lpModel.BuildTime() << ", solve: " << lpModel.SolveTime()
+                      << (lpModel.UsedMIP() ? ", MIP fallback" : "") << ")" << std::endl;
             std::cout << "Hungarian_Answer: " << answer_hunAlgo <<  ", Time: " << duration_hunAlgo.count() << " microseconds" << std::endl;
+            std::cout << "NetworkSimplex Answer: " << answer_NetworkSimplex << ", Time: " << duration_NetworkSimplex.count() << " microseconds"
+                      << ", Edges: " << edges_NetworkSimplex << std::endl;
+            std::cout << "CostScaling Answer: " << answer_CostScaling << ", Time: " << duration_CostScaling.count() << " microseconds"
+                      << ", Edges: " << edges_CostScaling << std::endl;
+            std::cout << "NetworkSimplex (k = " << lemon_candidates << ") Answer: " << answer_NetworkSimplex_k
+                      << ", Time: " << duration_NetworkSimplex_k.count() << " microseconds, Edges: " << edges_NetworkSimplex_k
+                      << ", Diff vs Hungarian: " << answer_hunAlgo - answer_NetworkSimplex_k << std::endl;
+            std::cout << "CostScaling (k = " << lemon_candidates << ") Answer: " << answer_CostScaling_k
+                      << ", Time: " << duration_CostScaling_k.count() << " microseconds, Edges: " << edges_CostScaling_k
+                      << ", Diff vs Hungarian: " << answer_hunAlgo - answer_CostScaling_k << std::endl;
 #ifdef COI_3_1_def
             std::cout << "COI_3_1 Answer: " << answer_3_1 << ", Time: " << duration_3_1.count() << " microseconds" << std::endl;
 #endif
             std::cout << "COI_3_7 Answer: " << answer_3_7 << ", Time: " << duration_3_7.count() << " microseconds" << std::endl;
             std::cout << "COI_3_9 Answer: " << answer_3_9 << ", Time: " << duration_3_9.count() << " microseconds" << std::endl;
             std::cout << "Auction_Answer: " << answer_Auction << ", Time: " << duration_Auction.count() << " microseconds" << std::endl;
+            std::cout << "GlobalGreedy Answer: " << answer_Greedy << ", Time: " << duration_Greedy.count() << " microseconds" << std::endl;
+            std::cout << "Sinkhorn Answer: " << answer_Sinkhorn << ", Time: " << duration_Sinkhorn.count() << " microseconds"
+                      << ", Gap vs Hungarian: " << 100.0 * (answer_hunAlgo - answer_Sinkhorn) / answer_hunAlgo << " %"
+                      << ", Iterations: " << sinkhornAlgo.Iterations() << std::endl;
+            std::cout << "COI_3_7 + LS Answer: " << answer_3_7 + gain_LS_3_7 << ", Time: " << duration_LS_3_7.count() << " microseconds" << std::endl;
+            std::cout << "COI_3_9 + LS Answer: " << answer_3_9 + gain_LS_3_9 << ", Time: " << duration_LS_3_9.count() << " microseconds" << std::endl;
+            std::cout << "Auction + LS Answer: " << answer_Auction + gain_LS_Auction << ", Time: " << duration_LS_Auction.count() << " microseconds" << std::endl;
+            std::cout << "Certificate: UB (auction prices) = " << cert_Auction.upper_bound
+                      << ", eps-CS violations: " << cert_Auction.violating_rows
+                      << ", UB (dual ascent) = " << cert_3_9.upper_bound
+                      << ", Time: " << duration_Cert.count() << " microseconds" << std::endl;
+            std::cout << "Guaranteed gap: COI_3_7 " << cert_3_7.gap << " (" << 100.0 * cert_3_7.relative_gap << " %)"
+                      << ", COI_3_9 " << cert_3_9.gap << " (" << 100.0 * cert_3_9.relative_gap << " %)"
+                      << ", Auction " << cert_Auction.gap << " (" << 100.0 * cert_Auction.relative_gap << " %)"
+                      << ", GlobalGreedy " << cert_Greedy.gap << " (" << 100.0 * cert_Greedy.relative_gap << " %)" << std::endl;
         }
         catch (const std::exception& e)
         {
@@ -213,6 +420,9 @@ int main(int argc, char *argv[])
         }
     }
 
+    // Экземпляр из файла может быть больше случайных
+    const int axis_max = std::max(NUM_ITERATIONS, *std::ranges::max_element(matrixSizes));
+
 #ifdef COI_3_1_def
     auto max_time_3_1 = *std::ranges::max_element(times_3_1);
 #endif
@@ -220,7 +430,11 @@ int main(int argc, char *argv[])
     auto max_time_3_9 = *std::ranges::max_element(times_3_9);
     auto max_time_LP  = *std::ranges::max_element(times_lpAlgo);
     auto max_time_hunAlgo = *std::ranges::max_element(times_hunAlgo);
+    auto max_time_NetworkSimplex = *std::ranges::max_element(times_NetworkSimplex);
+    auto max_time_CostScaling = *std::ranges::max_element(times_CostScaling);
     auto max_time_Auction = *std::ranges::max_element(times_Auction);
+    auto max_time_Greedy = *std::ranges::max_element(times_Greedy);
+    auto max_time_Sinkhorn = *std::ranges::max_element(times_Sinkhorn);
 
     auto max_diff_1 =     *std::max_element(answer_diffs_1.begin(), answer_diffs_1.end(),
                                             [](double a, double b) { return std::abs(a) < std::abs(b); });
@@ -238,6 +452,9 @@ int main(int argc, char *argv[])
     auto max_diff_5 =     *std::max_element(answer_diffs_5.begin(), answer_diffs_5.end(),
                                             [](double a, double b) { return std::abs(a) < std::abs(b); });
 
+    auto max_diff_6 =     *std::max_element(answer_diffs_6.begin(), answer_diffs_6.end(),
+                                            [](double a, double b) { return std::abs(a) < std::abs(b); });
+
 
     //// ============================================================================================================
 
@@ -247,29 +464,37 @@ int main(int argc, char *argv[])
     series_time_LP->setName("LP Time");
     QLineSeries *series_time_hunAlgo = new QLineSeries();
     series_time_hunAlgo->setName("HungarianAlgo Time");
+    QLineSeries *series_time_NetworkSimplex = new QLineSeries();
+    series_time_NetworkSimplex->setName("LEMON NetworkSimplex Time");
+    QLineSeries *series_time_CostScaling = new QLineSeries();
+    series_time_CostScaling->setName("LEMON CostScaling Time");
 
     for (size_t i = 0; i < matrixSizes.size(); ++i)
     {
         series_time_LP->append(matrixSizes[i], times_lpAlgo[i]);
         series_time_hunAlgo->append(matrixSizes[i], times_hunAlgo[i]);
+        series_time_NetworkSimplex->append(matrixSizes[i], times_NetworkSimplex[i]);
+        series_time_CostScaling->append(matrixSizes[i], times_CostScaling[i]);
     }
 
     QChart *chart_time = new QChart();
 
     chart_time->addSeries(series_time_LP);
     chart_time->addSeries(series_time_hunAlgo);
+    chart_time->addSeries(series_time_NetworkSimplex);
+    chart_time->addSeries(series_time_CostScaling);
     chart_time->setTitle("Execution Time vs Matrix Size");
     chart_time->legend()->setAlignment(Qt::AlignBottom);
 
     QValueAxis *axisX_time = new QValueAxis();
     axisX_time->setTitleText("Matrix Size (n)");
-    axisX_time->setRange(0, NUM_ITERATIONS);
+    axisX_time->setRange(0, axis_max);
     axisX_time->setLabelFormat("%.0f");
 
     QLogValueAxis *axisY_time = new QLogValueAxis();
     axisY_time->setTitleText("Time (microseconds)");
     axisY_time->setBase(10); // Основание логарифма (10 или e)
-    axisY_time->setRange(0.01, std::max<long long>(max_time_hunAlgo, max_time_LP) );
+    axisY_time->setRange(0.01, std::max<long long>({max_time_hunAlgo, max_time_LP, max_time_NetworkSimplex, max_time_CostScaling}) );
 
     axisY_time->setLabelFormat("%.0e"); // Формат: 1e+06, 1e+05, ... 1e+00
 
@@ -280,6 +505,10 @@ int main(int argc, char *argv[])
     series_time_LP->attachAxis(axisY_time);
     series_time_hunAlgo->attachAxis(axisX_time);
     series_time_hunAlgo->attachAxis(axisY_time);
+    series_time_NetworkSimplex->attachAxis(axisX_time);
+    series_time_NetworkSimplex->attachAxis(axisY_time);
+    series_time_CostScaling->attachAxis(axisX_time);
+    series_time_CostScaling->attachAxis(axisY_time);
 
     QChartView *chartView_time = new QChartView(chart_time);
     chartView_time->setRenderHint(QPainter::Antialiasing);
@@ -309,6 +538,10 @@ int main(int argc, char *argv[])
     series_time_3_9->setName("COI_3_9 Time");
     QLineSeries *series_time_Auction = new QLineSeries();
     series_time_Auction->setName("Auction Time");
+    QLineSeries *series_time_Greedy = new QLineSeries();
+    series_time_Greedy->setName("GlobalGreedy Time");
+    QLineSeries *series_time_Sinkhorn = new QLineSeries();
+    series_time_Sinkhorn->setName("Sinkhorn Time");
 
     for (size_t i = 0; i < matrixSizes.size(); ++i)
     {
@@ -319,6 +552,8 @@ int main(int argc, char *argv[])
         series_time_3_7->append(matrixSizes[i], times_3_7[i]);
         series_time_3_9->append(matrixSizes[i], times_3_9[i]);
         series_time_Auction->append(matrixSizes[i], times_Auction[i]);
+        series_time_Greedy->append(matrixSizes[i], times_Greedy[i]);
+        series_time_Sinkhorn->append(matrixSizes[i], times_Sinkhorn[i]);
     }
 
     QChart *chart_time_2 = new QChart();
@@ -330,12 +565,14 @@ int main(int argc, char *argv[])
     chart_time_2->addSeries(series_time_3_7);
     chart_time_2->addSeries(series_time_3_9);
     chart_time_2->addSeries(series_time_Auction);
+    chart_time_2->addSeries(series_time_Greedy);
+    chart_time_2->addSeries(series_time_Sinkhorn);
     chart_time_2->setTitle("Execution Time vs Matrix Size");
     chart_time_2->legend()->setAlignment(Qt::AlignBottom);
 
     QValueAxis *axisX_time_2 = new QValueAxis();
     axisX_time_2->setTitleText("Matrix Size (n)");
-    axisX_time_2->setRange(0, NUM_ITERATIONS);
+    axisX_time_2->setRange(0, axis_max);
     axisX_time_2->setLabelFormat("%.0f");
 
 
@@ -343,10 +580,10 @@ int main(int argc, char *argv[])
     QValueAxis *axisY_time_2 = new QValueAxis();
     axisY_time_2->setTitleText("Time (microseconds)");
 #ifdef COI_3_1_def
-    axisY_time->setRange( 0, std::max<long long>({max_time_3_9, max_time_3_7, max_time_hunAlgo, max_time_3_1, max_time_Auction}) );
+    axisY_time->setRange( 0, std::max<long long>({max_time_3_9, max_time_3_7, max_time_hunAlgo, max_time_3_1, max_time_Auction, max_time_Greedy, max_time_Sinkhorn}) );
     axisX_time_2->setLabelFormat("%.0e");
 #else
-    axisY_time_2->setRange(0, std::max<long long>({max_time_3_7, max_time_3_9, max_time_hunAlgo}) );
+    axisY_time_2->setRange(0, std::max<long long>({max_time_3_7, max_time_3_9, max_time_hunAlgo, max_time_Greedy, max_time_Sinkhorn}) );
 #endif
 #else
     QLogValueAxis *axisY_time_2 = new QLogValueAxis();
@@ -373,6 +610,10 @@ int main(int argc, char *argv[])
     series_time_3_7->attachAxis(axisY_time_2);
     series_time_3_9->attachAxis(axisX_time_2);
     series_time_3_9->attachAxis(axisY_time_2);
+    series_time_Greedy->attachAxis(axisX_time_2);
+    series_time_Greedy->attachAxis(axisY_time_2);
+    series_time_Sinkhorn->attachAxis(axisX_time_2);
+    series_time_Sinkhorn->attachAxis(axisY_time_2);
 
     QChartView *chartView_time_2 = new QChartView(chart_time_2);
     chartView_time_2->setRenderHint(QPainter::Antialiasing);
@@ -402,7 +643,7 @@ int main(int argc, char *argv[])
 
     QValueAxis *axisX_diff_1 = new QValueAxis();
     axisX_diff_1->setTitleText("Matrix Size (n)");
-    axisX_diff_1->setRange(0, NUM_ITERATIONS);
+    axisX_diff_1->setRange(0, axis_max);
     axisX_diff_1->setLabelFormat("%.0f");
 
     QValueAxis *axisY_diff_1 = new QValueAxis();
@@ -444,7 +685,7 @@ int main(int argc, char *argv[])
 
     QValueAxis *axisX_diff_2 = new QValueAxis();
     axisX_diff_2->setTitleText("Matrix Size (n)");
-    axisX_diff_2->setRange(0, NUM_ITERATIONS);
+    axisX_diff_2->setRange(0, axis_max);
     axisX_diff_2->setLabelFormat("%.0f");
 
     QValueAxis *axisY_diff_2 = new QValueAxis();
@@ -487,7 +728,7 @@ int main(int argc, char *argv[])
 
     QValueAxis *axisX_diff_3 = new QValueAxis();
     axisX_diff_3->setTitleText("Matrix Size (n)");
-    axisX_diff_3->setRange(0, NUM_ITERATIONS);
+    axisX_diff_3->setRange(0, axis_max);
     axisX_diff_3->setLabelFormat("%.0f");
 
     QValueAxis *axisY_diff_3 = new QValueAxis();
@@ -528,7 +769,7 @@ int main(int argc, char *argv[])
 
     QValueAxis *axisX_diff_4 = new QValueAxis();
     axisX_diff_4->setTitleText("Matrix Size (n)");
-    axisX_diff_4->setRange(0, NUM_ITERATIONS);
+    axisX_diff_4->setRange(0, axis_max);
     axisX_diff_4->setLabelFormat("%.0f");
 
     QValueAxis *axisY_diff_4 = new QValueAxis();
@@ -569,7 +810,7 @@ int main(int argc, char *argv[])
 
     QValueAxis *axisX_diff_5 = new QValueAxis();
     axisX_diff_5->setTitleText("Matrix Size (n)");
-    axisX_diff_5->setRange(0, NUM_ITERATIONS);
+    axisX_diff_5->setRange(0, axis_max);
     axisX_diff_5->setLabelFormat("%.0f");
 
     QValueAxis *axisY_diff_5 = new QValueAxis();
@@ -592,6 +833,47 @@ int main(int argc, char *argv[])
     window_diff_5.setWindowTitle("Answer Difference vs Matrix Size");
     window_diff_5.show();
 
+    //// ============================================================================================================
+
+
+    QLineSeries *series_diff_6 = new QLineSeries();
+    series_diff_6->setName("Answer Difference (Hungarian - GlobalGreedy)");
+
+    for (size_t i = 0; i < matrixSizes.size(); ++i)
+    {
+        series_diff_6->append(matrixSizes[i], answer_diffs_6[i]);
+    }
+
+    QChart *chart_diff_6 = new QChart();
+    chart_diff_6->addSeries(series_diff_6);
+    chart_diff_6->setTitle("Answer Difference vs Matrix Size");
+    chart_diff_6->legend()->setAlignment(Qt::AlignBottom);
+
+    QValueAxis *axisX_diff_6 = new QValueAxis();
+    axisX_diff_6->setTitleText("Matrix Size (n)");
+    axisX_diff_6->setRange(0, axis_max);
+    axisX_diff_6->setLabelFormat("%.0f");
+
+    QValueAxis *axisY_diff_6 = new QValueAxis();
+    axisY_diff_6->setTitleText("Answer Difference");
+    axisY_diff_6->setRange(-max_diff_6, max_diff_6);
+    axisY_diff_6->setLabelFormat("%.0f");
+
+    chart_diff_6->addAxis(axisX_diff_6, Qt::AlignBottom);
+    chart_diff_6->addAxis(axisY_diff_6, Qt::AlignLeft);
+
+    series_diff_6->attachAxis(axisX_diff_6);
+    series_diff_6->attachAxis(axisY_diff_6);
+
+    QChartView *chartView_diff_6 = new QChartView(chart_diff_6);
+    chartView_diff_6->setRenderHint(QPainter::Antialiasing);
+
+    QMainWindow window_diff_6;
+    window_diff_6.setCentralWidget(chartView_diff_6);
+    window_diff_6.resize(800, 600);
+    window_diff_6.setWindowTitle("Answer Difference vs Matrix Size");
+    window_diff_6.show();
+
 
 #endif
 
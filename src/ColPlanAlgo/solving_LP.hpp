@@ -1,93 +1,494 @@
+#ifndef SOLVING_LP_HPP
+#define SOLVING_LP_HPP
+
 #include <glpk.h> //GLPK (GNU Linear Programming Kit).
 #include <iostream>
 #include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <cstdint>
+#include <stdexcept>
 
-template<typename T>
-double solveAssignmentProblem_LP(std::vector<std::vector<T>>& d)
+// Дополнительное линейное ограничение sum c_k * x_{robot_k, target_k} <= upper,
+// например бюджет энергии робота. Слагаемые для запрещённых пар игнорируются.
+struct LPSideConstraint
+{
+    std::vector<std::pair<int, int>> pairs; // (робот, цель)
+    std::vector<double> coefs;
+    double upper = 0.0;
+};
+
+
+// Модель задачи о назначениях в GLPK, которую можно решать многократно.
+//
+// n роботов, m целей, переменные x_{i,j} in {0, 1} только для разрешённых пар:
+//     sum_j x_{i,j} <= 1        для каждого робота (3.4),
+//     sum_i x_{i,j} <= N_max[j] для каждой цели (3.5),
+//     плюс побочные ограничения LPSideConstraint.
+// Разрешённые пары - все, кроме SetForbiddenPairs, либо только SetCandidatePairs;
+// во втором случае читаются лишь d[i][j] кандидатов и плотная матрица не нужна.
+//
+// Структура ограничений строится один раз и перестраивается только при смене размера,
+// списка пар или побочных ограничений. Последующие вызовы Solve меняют лишь
+// коэффициенты целевой функции и границы N_max. Имена строк и столбцов по умолчанию
+// не задаются - это по строке в куче на каждую переменную.
+//
+// Без побочных ограничений многогранник вполне унимодулярен, поэтому вершина, найденная
+// симплекс-методом, уже целочисленна. В режиме Relaxation решается только LP-релаксация,
+// а glp_intopt вызывается лишь если решение оказалось дробным. Режим MIP сохраняет
+// прежнее поведение.
+class LPAssignmentModel
+{
+public:
+    enum class Mode
+    {
+        Relaxation,
+        MIP
+    };
+
+    LPAssignmentModel() noexcept = default;
+    ~LPAssignmentModel();
+
+    LPAssignmentModel(const LPAssignmentModel&) = delete;
+    LPAssignmentModel& operator=(const LPAssignmentModel&) = delete;
+
+    void SetNames(bool enabled) noexcept { names = enabled; dirty = true; }
+    void SetMode(Mode value) noexcept { mode = value; }
+
+    void SetForbiddenPairs(std::vector<std::pair<int, int>> pairs);
+    void SetCandidatePairs(std::vector<std::pair<int, int>> pairs);
+    void ClearCandidatePairs();
+    void AddSideConstraint(LPSideConstraint constraint);
+    void ClearSideConstraints();
+
+    // Квадратная матрица, по одному роботу на цель
+    template<typename T>
+    double Solve(const std::vector<std::vector<T>>& d);
+    template<typename T>
+    double Solve(const std::vector<std::vector<T>>& d, std::vector<int>& assignment);
+
+    // Общий случай: Matrix - любой тип с доступом d[i][j] для разрешённых пар
+    template<typename Matrix>
+    double Solve(std::size_t n, std::size_t m, const Matrix& d, const std::vector<int>& N_max,
+                 std::vector<int>& assignment);
+
+    // Понадобился ли в последнем вызове Solve метод ветвей и границ
+    [[nodiscard]] bool UsedMIP() const noexcept { return used_mip; }
+    [[nodiscard]] std::size_t NumVariables() const noexcept { return vars.size(); }
+
+    // Время последнего вызова Solve, мкс: построение/обновление модели и сам решатель
+    [[nodiscard]] long long BuildTime() const noexcept { return build_time; }
+    [[nodiscard]] long long SolveTime() const noexcept { return solve_time; }
+
+private:
+    void Build(std::size_t n, std::size_t m);
+    [[nodiscard]] int FindVariable(int robot, int target) const;
+    [[nodiscard]] bool IsIntegral() const;
+
+    [[nodiscard]] std::vector<std::uint64_t> PairKeys(const std::vector<std::pair<int, int>>& pairs) const;
+
+private:
+    glp_prob *lp = nullptr;
+    std::size_t num_rows = 0;
+    std::size_t num_cols = 0;
+    bool dirty = true;
+    bool names = false;
+    Mode mode = Mode::Relaxation;
+    bool used_mip = false;
+
+    std::vector<std::pair<int, int>> forbidden;
+    std::vector<std::pair<int, int>> candidates;
+    bool use_candidates = false;
+    std::vector<LPSideConstraint> side_constraints;
+
+    // Столбец GLPK k + 1 - пара vars[k]; var_keys[k] = i * m + j по возрастанию
+    std::vector<std::pair<int, int>> vars;
+    std::vector<std::uint64_t> var_keys;
+
+    std::vector<int> ia; // Индексы строк
+    std::vector<int> ja; // Индексы столбцов
+    std::vector<double> ar; // Значения
+
+    long long build_time = 0;
+    long long solve_time = 0;
+};
+
+
+inline LPAssignmentModel::~LPAssignmentModel()
+{
+    if (lp)
+        glp_delete_prob(lp);
+}
+
+
+inline void LPAssignmentModel::SetForbiddenPairs(std::vector<std::pair<int, int>> pairs)
+{
+    forbidden = std::move(pairs);
+    dirty = true;
+}
+
+
+inline void LPAssignmentModel::SetCandidatePairs(std::vector<std::pair<int, int>> pairs)
+{
+    candidates = std::move(pairs);
+    use_candidates = true;
+    dirty = true;
+}
+
+
+inline void LPAssignmentModel::ClearCandidatePairs()
+{
+    candidates.clear();
+    use_candidates = false;
+    dirty = true;
+}
+
+
+inline void LPAssignmentModel::AddSideConstraint(LPSideConstraint constraint)
+{
+    if (constraint.pairs.size() != constraint.coefs.size())
+    {
+        throw std::invalid_argument("Side constraint pairs and coefficients differ in size");
+    }
+
+    side_constraints.push_back(std::move(constraint));
+    dirty = true;
+}
+
+
+inline void LPAssignmentModel::ClearSideConstraints()
+{
+    side_constraints.clear();
+    dirty = true;
+}
+
+
+// Ключи i * m + j для пар внутри n x m, отсортированные и без повторов
+inline std::vector<std::uint64_t> LPAssignmentModel::PairKeys(const std::vector<std::pair<int, int>>& pairs) const
+{
+    std::vector<std::uint64_t> keys;
+    keys.reserve(pairs.size());
+    for (const auto& [i, j] : pairs)
+    {
+        if (i < 0 || j < 0 || static_cast<std::size_t>(i) >= num_rows || static_cast<std::size_t>(j) >= num_cols)
+            continue;
+        keys.push_back(static_cast<std::uint64_t>(i) * num_cols + j);
+    }
+
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+}
+
+
+inline int LPAssignmentModel::FindVariable(int robot, int target) const
+{
+    if (robot < 0 || target < 0 || static_cast<std::size_t>(robot) >= num_rows
+        || static_cast<std::size_t>(target) >= num_cols)
+        return -1;
+
+    std::uint64_t key = static_cast<std::uint64_t>(robot) * num_cols + target;
+    auto it = std::lower_bound(var_keys.begin(), var_keys.end(), key);
+    if (it == var_keys.end() || *it != key)
+        return -1;
+    return static_cast<int>(it - var_keys.begin());
+}
+
+
+inline void LPAssignmentModel::Build(std::size_t n, std::size_t m)
 {
-    glp_prob *lp = glp_create_prob();
+    if (lp)
+        glp_erase_prob(lp);
+    else
+        lp = glp_create_prob();
+
+    num_rows = n;
+    num_cols = m;
+    dirty = false;
+
     glp_set_prob_name(lp, "AssignmentProblem");
     glp_set_obj_dir(lp, GLP_MAX); // Максимизация
 
-    const int n = d.size();
+    // Разрешённые пары
+    if (use_candidates)
+    {
+        var_keys = PairKeys(candidates);
+    }
+    else
+    {
+        var_keys.resize(n * m);
+        for (std::size_t key = 0; key < n * m; key++)
+            var_keys[key] = key;
+    }
+
+    if (!forbidden.empty())
+    {
+        std::vector<std::uint64_t> banned = PairKeys(forbidden);
+        std::vector<std::uint64_t> allowed;
+        allowed.reserve(var_keys.size());
+        std::set_difference(var_keys.begin(), var_keys.end(), banned.begin(), banned.end(),
+                            std::back_inserter(allowed));
+        var_keys.swap(allowed);
+    }
 
-    int num_vars = n * n;
-    glp_add_cols(lp, num_vars);
+    vars.resize(var_keys.size());
+    for (std::size_t k = 0; k < var_keys.size(); k++)
+        vars[k] = {static_cast<int>(var_keys[k] / m), static_cast<int>(var_keys[k] % m)};
 
-    for (int j = 0; j < n; j++)
+    const int num_vars = static_cast<int>(vars.size());
+    if (num_vars > 0)
+        glp_add_cols(lp, num_vars);
+
+    for (int k = 0; k < num_vars; k++)
     {
-        for (int l = 0; l < n; l++)
-        {
-            int idx = j * n + l + 1; // Индекс переменной (1-based в GLPK)
-            glp_set_col_name(lp, idx, ("n_" + std::to_string(j+1) + "_" + std::to_string(l+1)).c_str());
-            glp_set_col_bnds(lp, idx, GLP_DB, 0.0, 1.0); // 0 <= n_{j,l} <= 1
-            glp_set_col_kind(lp, idx, GLP_BV); // Бинарная переменная (0 или 1)
-            glp_set_obj_coef(lp, idx, d[j][l]); // Коэффициент в целевой функции
-        }
+        int idx = k + 1; // Индекс переменной (1-based в GLPK)
+        if (names)
+            glp_set_col_name(lp, idx, ("n_" + std::to_string(vars[k].first + 1) + "_" + std::to_string(vars[k].second + 1)).c_str());
+        glp_set_col_bnds(lp, idx, GLP_DB, 0.0, 1.0); // 0 <= n_{i,j} <= 1
+        glp_set_col_kind(lp, idx, GLP_BV); // Бинарная переменная (0 или 1)
+    }
+
+    // n строк для ограничений (3.4), m для (3.5), затем побочные ограничения.
+    // Границы строк целей задаются в Solve, так как N_max может меняться между вызовами
+    const int total_rows = static_cast<int>(n + m + side_constraints.size());
+    if (total_rows > 0)
+        glp_add_rows(lp, total_rows);
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        if (names)
+            glp_set_row_name(lp, i + 1, ("robot_" + std::to_string(i + 1)).c_str());
+        glp_set_row_bnds(lp, i + 1, GLP_UP, 0.0, 1.0); // Сумма <= 1
     }
 
-    glp_add_rows(lp, n); // N строк для ограничений (3.4)
-    for (int j = 0; j < n; j++)
+    for (std::size_t j = 0; j < m; j++)
     {
-        glp_set_row_name(lp, j + 1, ("robot_" + std::to_string(j+1)).c_str());
-        glp_set_row_bnds(lp, j + 1, GLP_FX, 1.0, 1.0); // Сумма = 1
+        if (names)
+            glp_set_row_name(lp, n + j + 1, ("target_" + std::to_string(j + 1)).c_str());
     }
 
-    glp_add_rows(lp, n); // Ещё N строк для ограничений (3.5)
-    for (int l = 0; l < n; l++)
+    for (std::size_t s = 0; s < side_constraints.size(); s++)
     {
-        glp_set_row_name(lp, n + l + 1, ("target_" + std::to_string(l+1)).c_str());
-        glp_set_row_bnds(lp, n + l + 1, GLP_FX, 1.0, 1.0); // Сумма = 1
+        int row = static_cast<int>(n + m + s + 1);
+        if (names)
+            glp_set_row_name(lp, row, ("side_" + std::to_string(s + 1)).c_str());
+        glp_set_row_bnds(lp, row, GLP_UP, 0.0, side_constraints[s].upper);
     }
 
-    // Заполняем матрицу ограничений
-    std::vector<int> ia(1); // Индексы строк
-    std::vector<int> ja(1); // Индексы столбцов
-    std::vector<double> ar(1); // Значения
-    int idx = 1;
+    // Заполняем матрицу ограничений: по два ненуля на переменную и слагаемые побочных
+    // ограничений (+1 - массивы GLPK 1-based)
+    std::size_t nnz = 2 * vars.size();
+    for (const auto& constraint : side_constraints)
+        nnz += constraint.pairs.size();
 
-    for (int j = 0; j < n; j++)
+    ia.assign(nnz + 1, 0);
+    ja.assign(nnz + 1, 0);
+    ar.assign(nnz + 1, 1.0);
+
+    std::size_t idx = 1;
+
+    for (int k = 0; k < num_vars; k++)
+    {
+        ia[idx] = vars[k].first + 1; // Строка (ограничение для робота i)
+        ja[idx] = k + 1; // Столбец (переменная n_{i,j})
+        idx++;
+
+        ia[idx] = static_cast<int>(n) + vars[k].second + 1; // Строка (ограничение для цели j)
+        ja[idx] = k + 1;
+        idx++;
+    }
+
+    std::vector<std::pair<int, double>> terms;
+    for (std::size_t s = 0; s < side_constraints.size(); s++)
     {
-        for (int l = 0; l < n; l++)
+        const auto& constraint = side_constraints[s];
+
+        terms.clear();
+        for (std::size_t t = 0; t < constraint.pairs.size(); t++)
+        {
+            int var = FindVariable(constraint.pairs[t].first, constraint.pairs[t].second);
+            if (var >= 0)
+                terms.push_back({var, constraint.coefs[t]});
+        }
+        std::sort(terms.begin(), terms.end());
+
+        // Повторы одной пары GLPK не принимает - коэффициенты складываются
+        for (std::size_t t = 0; t < terms.size(); t++)
         {
-            ia.push_back(j + 1); // Строка (ограничение для робота j)
-            ja.push_back(j * n + l + 1); // Столбец (переменная n_{j,l})
-            ar.push_back(1.0); // Коэффициент
+            if (t > 0 && terms[t].first == terms[t - 1].first)
+            {
+                ar[idx - 1] += terms[t].second;
+                continue;
+            }
+            ia[idx] = static_cast<int>(n + m + s + 1);
+            ja[idx] = terms[t].first + 1;
+            ar[idx] = terms[t].second;
             idx++;
         }
     }
 
-    for (int l = 0; l < n; l++)
+    // Загружаем матрицу ограничений
+    glp_load_matrix(lp, static_cast<int>(idx - 1), ia.data(), ja.data(), ar.data());
+}
+
+
+inline bool LPAssignmentModel::IsIntegral() const
+{
+    const double tolerance = 1e-6;
+    const int num_vars = static_cast<int>(vars.size());
+
+    for (int idx = 1; idx <= num_vars; idx++)
+    {
+        double value = glp_get_col_prim(lp, idx);
+        if (value > tolerance && value < 1.0 - tolerance)
+            return false;
+    }
+    return true;
+}
+
+
+template<typename T>
+double LPAssignmentModel::Solve(const std::vector<std::vector<T>>& d)
+{
+    std::vector<int> assignment;
+    return Solve(d, assignment);
+}
+
+
+template<typename T>
+double LPAssignmentModel::Solve(const std::vector<std::vector<T>>& d, std::vector<int>& assignment)
+{
+    const std::size_t n = d.size();
+    for (const auto& row : d)
     {
-        for (int j = 0; j < n; j++)
+        if (row.size() != n)
         {
-            ia.push_back(n + l + 1); // Строка (ограничение для цели l)
-            ja.push_back(j * n + l + 1); // Столбец (переменная n_{j,l})
-            ar.push_back(1.0); // Коэффициент
-            idx++;
+            throw std::invalid_argument("LPAssignmentModel expects a square matrix");
         }
     }
 
-    // Загружаем матрицу ограничений
-    glp_load_matrix(lp, idx - 1, ia.data(), ja.data(), ar.data());
+    return Solve(n, n, d, std::vector<int>(n, 1), assignment);
+}
+
+
+template<typename Matrix>
+double LPAssignmentModel::Solve(std::size_t n, std::size_t m, const Matrix& d, const std::vector<int>& N_max,
+                                std::vector<int>& assignment)
+{
+    using namespace std::chrono;
+
+    if (N_max.size() != m)
+    {
+        throw std::invalid_argument("Invalid size of N_max for LPAssignmentModel");
+    }
+
+    // Ранние выходы ниже не должны оставлять времена и режим прошлого вызова
+    assignment.assign(n, -1);
+    used_mip = false;
+    build_time = 0;
+    solve_time = 0;
+    if (n == 0 || m == 0)
+        return 0.0;
+
+    auto start_build = high_resolution_clock::now();
+
+    if (!lp || dirty || num_rows != n || num_cols != m)
+        Build(n, m);
+
+    if (vars.empty())
+    {
+        build_time = duration_cast<microseconds>(high_resolution_clock::now() - start_build).count();
+        return 0.0;
+    }
+
+    for (std::size_t j = 0; j < m; j++)
+    {
+        int row = static_cast<int>(n + j + 1);
+        if (N_max[j] > 0)
+            glp_set_row_bnds(lp, row, GLP_UP, 0.0, N_max[j]); // Сумма <= N_max
+        else
+            glp_set_row_bnds(lp, row, GLP_FX, 0.0, 0.0);
+    }
+
+    for (std::size_t k = 0; k < vars.size(); k++)
+    {
+        glp_set_obj_coef(lp, k + 1, d[vars[k].first][vars[k].second]); // Коэффициент в целевой функции
+    }
+
+    auto end_build = high_resolution_clock::now();
 
     // Настраиваем параметры для отключения вывода
     glp_smcp parm_simplex;
     glp_init_smcp(&parm_simplex);
     parm_simplex.msg_lev = GLP_MSG_OFF; // Отключаем сообщения симплекс-метода
 
-    glp_iocp parm_intopt;
-    glp_init_iocp(&parm_intopt);
-    parm_intopt.msg_lev = GLP_MSG_OFF; // Отключаем сообщения MILP
+    // Сначала симплекс-метод без вывода
+    if (glp_simplex(lp, &parm_simplex) != 0 || glp_get_status(lp) != GLP_OPT)
+    {
+        throw std::runtime_error("GLPK simplex failed to find an optimal solution");
+    }
 
-    // Решаем задачу
-    glp_simplex(lp, &parm_simplex); // Сначала симплекс-метод без вывода
-    glp_intopt(lp, &parm_intopt);   // Затем целочисленное решение без вывода
+    used_mip = (mode == Mode::MIP) || !IsIntegral();
 
-    // Получаем результат
-    double z = glp_mip_obj_val(lp); // Значение целевой функции
+    double z;
+    if (used_mip)
+    {
+        glp_iocp parm_intopt;
+        glp_init_iocp(&parm_intopt);
+        parm_intopt.msg_lev = GLP_MSG_OFF; // Отключаем сообщения MILP
+
+        // Затем целочисленное решение без вывода
+        if (glp_intopt(lp, &parm_intopt) != 0 || glp_mip_status(lp) != GLP_OPT)
+        {
+            throw std::runtime_error("GLPK failed to find an optimal integer solution");
+        }
+        z = glp_mip_obj_val(lp); // Значение целевой функции
+    }
+    else
+    {
+        z = glp_get_obj_val(lp);
+    }
+
+    // Назначение робот -> цель
+    for (std::size_t k = 0; k < vars.size(); k++)
+    {
+        double value = used_mip ? glp_mip_col_val(lp, k + 1) : glp_get_col_prim(lp, k + 1);
+        if (value > 0.5)
+            assignment[vars[k].first] = vars[k].second;
+    }
+
+    auto end_solve = high_resolution_clock::now();
+
+    build_time = duration_cast<microseconds>(end_build - start_build).count();
+    solve_time = duration_cast<microseconds>(end_solve - end_build).count();
 
-    // Очищаем память
-    glp_delete_prob(lp);
     return z;
 }
+
+
+template<typename T>
+double solveAssignmentProblem_LP(std::vector<std::vector<T>>& d)
+{
+    LPAssignmentModel model;
+    return model.Solve(d);
+}
+
+template<typename T>
+double solveAssignmentProblem_LP(std::vector<std::vector<T>>& d, std::vector<int>& assignment)
+{
+    LPAssignmentModel model;
+    return model.Solve(d, assignment);
+}
+
+// Прямоугольный экземпляр n x m с ёмкостями целей N_max
+template<typename T>
+double solveAssignmentProblem_LP(std::vector<std::vector<T>>& d, std::vector<int>& N_max, std::vector<int>& assignment)
+{
+    LPAssignmentModel model;
+    return model.Solve(d.size(), N_max.size(), d, N_max, assignment);
+}
+
+#endif // SOLVING_LP_HPP
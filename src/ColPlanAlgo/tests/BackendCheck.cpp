@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../HungarianAlgo.hpp"
+#include "../solving_LP.hpp"
+#include "ExactInstances.hpp"
+
+// Сверка модели GLPK (LPAssignmentModel) с HungarionAlgo на малых экземплярах
+
+namespace
+{
+
+void CheckInstance(int n, int m, std::mt19937& generator, LPAssignmentModel& reused_model)
+{
+    std::vector<std::vector<double>> D = RandomUtilities(n, m, generator);
+    std::vector<int> N_max(m, 1);
+
+    HungarionAlgo<double> hungarian(n, m, D, N_max);
+    const double optimum = hungarian.Start();
+
+    // Свежая модель, модель, переживающая смену размеров, и режим MIP
+    LPAssignmentModel model;
+    std::vector<int> assignment;
+    double answer = model.Solve(n, m, D, N_max, assignment);
+    CHECK(std::abs(answer - optimum) < exact_tolerance);
+    CheckAssignment(D, N_max, assignment, answer);
+
+    answer = reused_model.Solve(n, m, D, N_max, assignment);
+    CHECK(std::abs(answer - optimum) < exact_tolerance);
+    CheckAssignment(D, N_max, assignment, answer);
+
+    LPAssignmentModel mip;
+    mip.SetMode(LPAssignmentModel::Mode::MIP);
+    answer = mip.Solve(n, m, D, N_max, assignment);
+    CHECK(mip.UsedMIP());
+    CHECK(std::abs(answer - optimum) < exact_tolerance);
+    CheckAssignment(D, N_max, assignment, answer);
+
+    // Без разрешённых пар Solve выходит до симплекса: режим и время прошлого
+    // вызова не должны просочиться в ответ
+    mip.SetCandidatePairs({});
+    answer = mip.Solve(n, m, D, N_max, assignment);
+    CHECK(answer == 0.0);
+    CHECK(!mip.UsedMIP());
+    CHECK(mip.SolveTime() == 0);
+    CHECK(std::count(assignment.begin(), assignment.end(), -1) == n);
+}
+
+}
+
+int main()
+{
+    std::mt19937 generator(20261019);
+    LPAssignmentModel reused_model;
+
+    for (const auto& size : exact_sizes)
+    {
+        for (int repeat = 0; repeat < 10; ++repeat)
+            CheckInstance(size[0], size[1], generator, reused_model);
+    }
+
+    return TestResult();
+}
@@ -0,0 +1,53 @@
+#ifndef EXACT_INSTANCES_HPP
+#define EXACT_INSTANCES_HPP
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "TestCheck.hpp"
+
+// Общее для сверок точных бэкендов с HungarionAlgo (backend_check, lemon_check).
+// Полезности целые и положительные, n <= m, N_max = 1: оптимумы всех решателей
+// совпадают точно, в том числе после масштабирования стоимостей в LEMON
+
+inline constexpr double exact_tolerance = 1e-6;
+
+inline constexpr int exact_sizes[][2] = {{1, 1}, {2, 2}, {3, 5}, {5, 5}, {6, 9}, {8, 8}, {10, 14}, {12, 12}};
+
+inline std::vector<std::vector<double>> RandomUtilities(int n, int m, std::mt19937& generator)
+{
+    std::uniform_int_distribution<int> utility(1, 100);
+    std::vector<std::vector<double>> D(n, std::vector<double>(m));
+    for (auto& row : D)
+        for (double& value : row)
+            value = utility(generator);
+    return D;
+}
+
+// Назначение допустимо и даёт заявленную сумму
+inline void CheckAssignment(const std::vector<std::vector<double>>& D, const std::vector<int>& N_max,
+                            const std::vector<int>& assignment, double answer)
+{
+    CHECK(assignment.size() == D.size());
+
+    std::vector<int> load(N_max.size(), 0);
+    double sum = 0.0;
+    for (std::size_t i = 0; i < assignment.size(); ++i)
+    {
+        int j = assignment[i];
+        if (j < 0)
+            continue;
+        CHECK(j < static_cast<int>(N_max.size()));
+        if (j >= static_cast<int>(N_max.size()))
+            return;
+        ++load[j];
+        sum += D[i][j];
+    }
+
+    for (std::size_t j = 0; j < N_max.size(); ++j)
+        CHECK(load[j] <= N_max[j]);
+    CHECK(std::abs(sum - answer) < exact_tolerance);
+}
+
+#endif
@@ -0,0 +1,52 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../HungarianAlgo.hpp"
+#include "../LemonAssignment.hpp"
+#include "ExactInstances.hpp"
+
+// Сверка потока минимальной стоимости LEMON (LemonAssignment) с HungarionAlgo
+// на малых экземплярах
+
+namespace
+{
+
+void CheckInstance(int n, int m, std::mt19937& generator)
+{
+    std::vector<std::vector<double>> D = RandomUtilities(n, m, generator);
+    std::vector<int> N_max(m, 1);
+
+    HungarionAlgo<double> hungarian(n, m, D, N_max);
+    const double optimum = hungarian.Start();
+
+    // Полный граф и k = n лучших задач строки - оба варианта точные
+    for (auto method : {LemonAssignment<double>::Method::NetworkSimplex, LemonAssignment<double>::Method::CostScaling})
+    {
+        for (std::size_t candidates : {std::size_t(0), std::size_t(n)})
+        {
+            LemonAssignment<double> lemon(n, m, D, N_max);
+            lemon.SetMethod(method);
+            lemon.SetCandidatesPerRow(candidates);
+            const double answer = lemon.Start();
+            CHECK(std::abs(answer - optimum) < exact_tolerance);
+            CheckAssignment(D, N_max, lemon.Assignment(), answer);
+        }
+    }
+}
+
+}
+
+int main()
+{
+    std::mt19937 generator(20261019);
+
+    for (const auto& size : exact_sizes)
+    {
+        for (int repeat = 0; repeat < 10; ++repeat)
+            CheckInstance(size[0], size[1], generator);
+    }
+
+    return TestResult();
+}
@@ -0,0 +1,62 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstddef>
+
+// Число потоков по умолчанию для параллельных решателей
+inline std::size_t DefaultThreadCount() noexcept
+{
+    std::size_t count = std::thread::hardware_concurrency();
+    return count ? count : 1;
+}
+
+// Сколько блоков создаст ParallelFor для диапазона длины total
+inline std::size_t ParallelBlockCount(std::size_t total, std::size_t min_chunk = 1, std::size_t threads = 0) noexcept
+{
+    if (!threads)
+        threads = DefaultThreadCount();
+
+    return std::max<std::size_t>(1, std::min(threads, total / std::max<std::size_t>(min_chunk, 1)));
+}
+
+// Делит [begin, end) на непрерывные блоки и выполняет body(block_begin, block_end, thread_index)
+// в отдельных потоках. Последний блок обрабатывает вызывающий поток.
+// Блоки меньше min_chunk не создаются, так что маленькие диапазоны идут в одном потоке.
+template<typename F>
+void ParallelFor(std::size_t begin, std::size_t end, F&& body,
+                 std::size_t min_chunk = 1, std::size_t threads = 0)
+{
+    if (end <= begin)
+        return;
+
+    const std::size_t total = end - begin;
+    threads = ParallelBlockCount(total, min_chunk, threads);
+
+    if (threads == 1)
+    {
+        body(begin, end, std::size_t(0));
+        return;
+    }
+
+    const std::size_t chunk = (total + threads - 1) / threads;
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+
+    for (std::size_t t = 0; t + 1 < threads; ++t)
+    {
+        std::size_t block_begin = begin + t * chunk;
+        std::size_t block_end = std::min(end, block_begin + chunk);
+        workers.emplace_back([&body, block_begin, block_end, t] { body(block_begin, block_end, t); });
+    }
+
+    body(std::min(end, begin + (threads - 1) * chunk), end, threads - 1);
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+#endif // PARALLEL_HPP
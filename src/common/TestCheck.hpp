@@ -0,0 +1,30 @@
+#ifndef TEST_CHECK
+#define TEST_CHECK
+
+#include <cstdio>
+
+// Минимальная проверка для тестов без внешних зависимостей: сообщение о провале
+// печатается, тест продолжается, итог - код возврата TestResult()
+inline int& TestFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                            \
+    do {                                                                            \
+        if (!(condition)) {                                                         \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__,   \
+                         #condition);                                               \
+            ++TestFailures();                                                       \
+        }                                                                           \
+    } while (false)
+
+inline int TestResult()
+{
+    if (TestFailures() != 0)
+        std::fprintf(stderr, "%d check(s) failed\n", TestFailures());
+    return TestFailures() == 0 ? 0 : 1;
+}
+
+#endif